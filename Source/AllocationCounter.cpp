@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.cpp
+    Created: 19 Oct 2026 4:54:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "AllocationCounter.h"
+
+#if GRADIENTDESIGNER_COUNT_ALLOCATIONS
+
+//==============================================================================
+namespace AllocationCounterHelpers
+{
+    static Atomic<int64> numAllocations;
+
+    inline void countAllocation() noexcept
+    {
+        ++numAllocations;
+    }
+}
+
+#if JUCE_LINUX && defined (__GLIBC__)
+
+// operator new uses malloc on Linux so wrapping these catches everything
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+
+    void* malloc (size_t size) throw()
+    {
+        AllocationCounterHelpers::countAllocation();
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t num, size_t size) throw()
+    {
+        AllocationCounterHelpers::countAllocation();
+        return __libc_calloc (num, size);
+    }
+
+    void* realloc (void* data, size_t size) throw()
+    {
+        AllocationCounterHelpers::countAllocation();
+        return __libc_realloc (data, size);
+    }
+}
+
+#elif JUCE_MAC
+
+#include <malloc/malloc.h>
+#include <sys/mman.h>
+
+//==============================================================================
+namespace AllocationCounterHelpers
+{
+    // malloc, operator new and the Objective-C runtime all end up in the default
+    // zone, so its function pointers are swapped for ones that count the calls
+    static void* (*zoneMalloc) (malloc_zone_t*, size_t) = nullptr;
+    static void* (*zoneCalloc) (malloc_zone_t*, size_t, size_t) = nullptr;
+    static void* (*zoneValloc) (malloc_zone_t*, size_t) = nullptr;
+    static void* (*zoneRealloc) (malloc_zone_t*, void*, size_t) = nullptr;
+
+    static void* countingMalloc (malloc_zone_t* zone, size_t size)
+    {
+        countAllocation();
+        return zoneMalloc (zone, size);
+    }
+
+    static void* countingCalloc (malloc_zone_t* zone, size_t num, size_t size)
+    {
+        countAllocation();
+        return zoneCalloc (zone, num, size);
+    }
+
+    static void* countingValloc (malloc_zone_t* zone, size_t size)
+    {
+        countAllocation();
+        return zoneValloc (zone, size);
+    }
+
+    static void* countingRealloc (malloc_zone_t* zone, void* data, size_t size)
+    {
+        countAllocation();
+        return zoneRealloc (zone, data, size);
+    }
+
+    struct HookInstaller
+    {
+        HookInstaller()
+        {
+            malloc_zone_t* const zone = malloc_default_zone();
+
+            // from version 8 the zone's functions live in read-only memory
+            const size_t pageSize = (size_t) getpagesize();
+            void* const zonePage = (void*) (((pointer_sized_uint) zone) & ~(pointer_sized_uint) (pageSize - 1));
+            const bool isProtected = zone->version >= 8;
+
+            if (isProtected)
+                mprotect (zonePage, pageSize, PROT_READ | PROT_WRITE);
+
+            zoneMalloc  = zone->malloc;   zone->malloc  = countingMalloc;
+            zoneCalloc  = zone->calloc;   zone->calloc  = countingCalloc;
+            zoneValloc  = zone->valloc;   zone->valloc  = countingValloc;
+            zoneRealloc = zone->realloc;  zone->realloc = countingRealloc;
+
+            if (isProtected)
+                mprotect (zonePage, pageSize, PROT_READ);
+        }
+    };
+
+    static HookInstaller hookInstaller;
+}
+
+#elif JUCE_WINDOWS
+
+#if ! defined (_DEBUG)
+ #error "Allocations can only be counted in debug builds on Windows, as they need the debug CRT's allocation hook"
+#endif
+
+#include <crtdbg.h>
+
+//==============================================================================
+namespace AllocationCounterHelpers
+{
+    // the debug CRT calls this for every malloc, calloc and realloc, and
+    // operator new goes through malloc
+    static int __cdecl allocationHook (int allocType, void*, size_t, int, long, const unsigned char*, int)
+    {
+        if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC)
+            countAllocation();
+
+        return TRUE;
+    }
+
+    struct HookInstaller
+    {
+        HookInstaller()     { _CrtSetAllocHook (allocationHook); }
+    };
+
+    static HookInstaller hookInstaller;
+}
+
+#else
+ #error "Allocations can't be counted on this platform"
+#endif
+
+//==============================================================================
+bool AllocationCounter::isEnabled() noexcept
+{
+    return true;
+}
+
+int64 AllocationCounter::getNumAllocations() noexcept
+{
+    return AllocationCounterHelpers::numAllocations.get();
+}
+
+#else
+
+//==============================================================================
+bool AllocationCounter::isEnabled() noexcept
+{
+    return false;
+}
+
+int64 AllocationCounter::getNumAllocations() noexcept
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.h
+    Created: 19 Oct 2026 4:54:56am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __ALLOCATIONCOUNTER_H_C5D8127E__
+#define __ALLOCATIONCOUNTER_H_C5D8127E__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/** Set this to 1 in the project's preprocessor definitions to count heap allocations.
+    It's off by default as it replaces the global allocation functions.
+ */
+#ifndef GRADIENTDESIGNER_COUNT_ALLOCATIONS
+ #define GRADIENTDESIGNER_COUNT_ALLOCATIONS 0
+#endif
+
+
+//==============================================================================
+/**
+    Keeps a count of the number of heap allocations made by the whole process.
+
+    This is used by the InteractionReplayer to check that editing a gradient doesn't
+    allocate once everything has warmed up. When GRADIENTDESIGNER_COUNT_ALLOCATIONS
+    is enabled every call to malloc, calloc and realloc is counted, which includes
+    operator new as well as HeapBlock and Array storage:
+
+    - on Linux the glibc functions are wrapped
+    - on the Mac the default malloc zone's functions are hooked
+    - on Windows the debug CRT's allocation hook is used, so counting only works
+      in debug builds there
+
+    @see InteractionReplayer
+ */
+class AllocationCounter
+{
+public:
+    //==============================================================================
+    /** Returns true if allocations are being counted in this build. */
+    static bool isEnabled() noexcept;
+
+    /** Returns the total number of allocations made so far.
+        This will always be 0 if counting isn't enabled.
+     */
+    static int64 getNumAllocations() noexcept;
+
+private:
+    //==============================================================================
+    AllocationCounter();
+    JUCE_DECLARE_NON_COPYABLE (AllocationCounter);
+};
+
+
+#endif  // __ALLOCATIONCOUNTER_H_C5D8127E__
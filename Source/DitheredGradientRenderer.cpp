@@ -0,0 +1,299 @@
+/*
+  ==============================================================================
+
+    DitheredGradientRenderer.cpp
+    Created: 19 Oct 2026 4:46:19am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "DitheredGradientRenderer.h"
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define GRADIENT_USE_SSE2 1
+ #include <emmintrin.h>
+#else
+ #define GRADIENT_USE_SSE2 0
+#endif
+
+
+//==============================================================================
+namespace DitheredGradientHelpers
+{
+    const uint8 bayerMatrix[8][8] =
+    {
+        {  0, 32,  8, 40,  2, 34, 10, 42 },
+        { 48, 16, 56, 24, 50, 18, 58, 26 },
+        { 12, 44,  4, 36, 14, 46,  6, 38 },
+        { 60, 28, 52, 20, 62, 30, 54, 22 },
+        {  3, 35, 11, 43,  1, 33,  9, 41 },
+        { 51, 19, 59, 27, 49, 17, 57, 25 },
+        { 15, 47,  7, 39, 13, 45,  5, 37 },
+        { 63, 31, 55, 23, 61, 29, 53, 21 }
+    };
+
+    inline float sRGBToLinear (float v) noexcept
+    {
+        return v <= 0.04045f ? v / 12.92f
+                             : std::pow ((v + 0.055f) / 1.055f, 2.4f);
+    }
+
+    inline float linearToSRGB (float v) noexcept
+    {
+        return v <= 0.0031308f ? v * 12.92f
+                               : 1.055f * std::pow (v, 1.0f / 2.4f) - 0.055f;
+    }
+
+    /** Describes how the gradient position changes across a row of pixels. */
+    struct RowParameters
+    {
+        bool isRadial;
+        float t0, dt;           // linear: t = t0 + x * dt
+        float cx, dy2, invR;    // radial: t = sqrt ((x - cx)^2 + dy2) * invR
+    };
+
+    inline float getPosition (const RowParameters& row, int x) noexcept
+    {
+        if (row.isRadial)
+        {
+            const float dx = x - row.cx;
+            return std::sqrt (dx * dx + row.dy2) * row.invR;
+        }
+
+        return row.t0 + x * row.dt;
+    }
+
+    inline int getLookupIndex (float t, int maxIndex) noexcept
+    {
+        return (int) (jlimit (0.0f, 1.0f, t) * maxIndex + 0.5f);
+    }
+
+    inline uint8 quantise (float v, float threshold) noexcept
+    {
+        // the threshold is in the range 0 to 1 so this rounds up or down
+        return (uint8) (int) (v + threshold);
+    }
+
+    void renderRowScalar (uint8* dest, int x, int endX, const RowParameters& row,
+                          const float* lookupTable, int maxIndex, const float* thresholds) noexcept
+    {
+        for (; x < endX; ++x)
+        {
+            const float* entry = lookupTable + 4 * getLookupIndex (getPosition (row, x), maxIndex);
+            const float threshold = thresholds[x & 7];
+
+            dest[4 * x]     = quantise (entry[0], threshold);
+            dest[4 * x + 1] = quantise (entry[1], threshold);
+            dest[4 * x + 2] = quantise (entry[2], threshold);
+            dest[4 * x + 3] = quantise (entry[3], threshold);
+        }
+    }
+
+   #if GRADIENT_USE_SSE2
+    void renderRowSSE2 (uint8* dest, int width, const RowParameters& row,
+                        const float* lookupTable, int maxIndex, const float* thresholds) noexcept
+    {
+        const __m128 offsets = _mm_set_ps (3.0f, 2.0f, 1.0f, 0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps (1.0f);
+        const __m128 scale = _mm_set1_ps ((float) maxIndex);
+        const __m128 half = _mm_set1_ps (0.5f);
+
+        // the threshold pattern repeats every 8 pixels so do two blocks of four at a time
+        const __m128 thresholdVectors[8] =
+        {
+            _mm_set1_ps (thresholds[0]), _mm_set1_ps (thresholds[1]),
+            _mm_set1_ps (thresholds[2]), _mm_set1_ps (thresholds[3]),
+            _mm_set1_ps (thresholds[4]), _mm_set1_ps (thresholds[5]),
+            _mm_set1_ps (thresholds[6]), _mm_set1_ps (thresholds[7])
+        };
+
+        int x = 0;
+
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128 xs = _mm_add_ps (_mm_set1_ps ((float) x), offsets);
+            __m128 t;
+
+            if (row.isRadial)
+            {
+                const __m128 dx = _mm_sub_ps (xs, _mm_set1_ps (row.cx));
+                t = _mm_mul_ps (_mm_sqrt_ps (_mm_add_ps (_mm_mul_ps (dx, dx), _mm_set1_ps (row.dy2))),
+                                _mm_set1_ps (row.invR));
+            }
+            else
+            {
+                t = _mm_add_ps (_mm_set1_ps (row.t0), _mm_mul_ps (xs, _mm_set1_ps (row.dt)));
+            }
+
+            t = _mm_min_ps (_mm_max_ps (t, zero), one);
+
+            int indexes[4];
+            _mm_storeu_si128 ((__m128i*) indexes, _mm_cvttps_epi32 (_mm_add_ps (_mm_mul_ps (t, scale), half)));
+
+            const __m128 * const thresholdBlock = thresholdVectors + (x & 4);
+            const __m128i p0 = _mm_cvttps_epi32 (_mm_add_ps (_mm_loadu_ps (lookupTable + 4 * indexes[0]), thresholdBlock[0]));
+            const __m128i p1 = _mm_cvttps_epi32 (_mm_add_ps (_mm_loadu_ps (lookupTable + 4 * indexes[1]), thresholdBlock[1]));
+            const __m128i p2 = _mm_cvttps_epi32 (_mm_add_ps (_mm_loadu_ps (lookupTable + 4 * indexes[2]), thresholdBlock[2]));
+            const __m128i p3 = _mm_cvttps_epi32 (_mm_add_ps (_mm_loadu_ps (lookupTable + 4 * indexes[3]), thresholdBlock[3]));
+
+            _mm_storeu_si128 ((__m128i*) (dest + 4 * x),
+                              _mm_packus_epi16 (_mm_packs_epi32 (p0, p1), _mm_packs_epi32 (p2, p3)));
+        }
+
+        renderRowScalar (dest, x, width, row, lookupTable, maxIndex, thresholds);
+    }
+   #endif
+}
+
+//==============================================================================
+DitheredGradientRenderer::DitheredGradientRenderer()
+    : lookupTable (4 * lookupTableSize), encodingTable (encodingTableSize + 1),
+      gammaCorrect (false), dithering (true)
+{
+    // a table of the sRGB curve, so that the entries of a gamma corrected lookup
+    // table can be encoded without calling std::pow for each of them
+    for (int i = 0; i <= encodingTableSize; ++i)
+        encodingTable[i] = DitheredGradientHelpers::linearToSRGB (i / (float) encodingTableSize);
+}
+
+DitheredGradientRenderer::~DitheredGradientRenderer()
+{
+}
+
+void DitheredGradientRenderer::render (const GradientModel& model, const Range<double>& range,
+                                       bool isRadial, Image& destImage)
+{
+    using namespace DitheredGradientHelpers;
+
+    jassert (destImage.getFormat() == Image::ARGB);
+    jassert (model.getNumStops() > 0);
+
+    createLookupTable (model, range);
+
+    const int width = destImage.getWidth();
+    const int height = destImage.getHeight();
+
+    // the lookup table covers the range, so the gradient runs from 0 to 1 between
+    // the left and right edges, or from the top-left to the bottom-right corner
+    const float dx = (float) width, dy = isRadial ? (float) height : 0.0f;
+    const float lengthSquared = jmax (1.0e-6f, dx * dx + dy * dy);
+
+    RowParameters row;
+    row.isRadial = isRadial;
+    row.cx = 0.0f;
+    row.invR = 1.0f / std::sqrt (lengthSquared);
+    row.dt = dx / lengthSquared;
+
+    const Image::BitmapData data (destImage, Image::BitmapData::writeOnly);
+    jassert (data.pixelStride == 4);
+
+    for (int y = 0; y < height; ++y)
+    {
+        row.t0 = y * dy / lengthSquared;
+        row.dy2 = (float) y * y;
+
+        float thresholds[8];
+
+        for (int i = 0; i < 8; ++i)
+            thresholds[i] = dithering ? (bayerMatrix[y & 7][i] + 0.5f) / 64.0f : 0.5f;
+
+        uint8* const dest = data.getLinePointer (y);
+
+       #if GRADIENT_USE_SSE2
+        renderRowSSE2 (dest, width, row, lookupTable, lookupTableSize - 1, thresholds);
+       #else
+        renderRowScalar (dest, 0, width, row, lookupTable, lookupTableSize - 1, thresholds);
+       #endif
+    }
+}
+
+//==============================================================================
+void DitheredGradientRenderer::createLookupTable (const GradientModel& model, const Range<double>& range)
+{
+    using namespace DitheredGradientHelpers;
+
+    // each entry holds premultiplied B, G, R, A in the range 0 to 255, which
+    // matches the byte order of a PixelARGB in memory
+    float* entry = lookupTable;
+    const int numStops = model.getNumStops();
+
+    // the stop after the current position is only searched for again once the
+    // position passes it, so each entry costs at most one binary search and the
+    // stops outside the range are never visited. The colours of the two stops
+    // either side are converted to the space they're interpolated in at the same
+    // time, rather than for every entry.
+    int nextStop = 0;
+    double nextStopPosition = -std::numeric_limits<double>::max();
+    double previousStopPosition = 0.0;
+    float c1[4] = { 0 }, c2[4] = { 0 };   // R, G, B, A
+
+    for (int i = 0; i < lookupTableSize; ++i)
+    {
+        const double position = range.getStart() + range.getLength() * i / (double) (lookupTableSize - 1);
+
+        if (position >= nextStopPosition)
+        {
+            nextStop = model.findFirstStopAfter (position);
+            nextStopPosition = nextStop < numStops ? model.getStopPosition (nextStop)
+                                                   : std::numeric_limits<double>::max();
+
+            if (numStops > 0)
+            {
+                // before the first stop or after the last one, both ends are the same stop
+                const int previousStop = jmax (0, nextStop - 1);
+
+                previousStopPosition = model.getStopPosition (previousStop);
+                getInterpolatedComponents (model.getStopColour (previousStop), c1);
+                getInterpolatedComponents (model.getStopColour (jmin (nextStop, numStops - 1)), c2);
+            }
+        }
+
+        const float proportion = (nextStop == 0 || nextStop >= numStops)
+                                    ? 0.0f
+                                    : (float) jlimit (0.0, 1.0, (position - previousStopPosition)
+                                                                  / (nextStopPosition - previousStopPosition));
+
+        float rgb[3];
+
+        for (int j = 0; j < 3; ++j)
+        {
+            rgb[j] = c1[j] + (c2[j] - c1[j]) * proportion;
+
+            if (gammaCorrect)
+                rgb[j] = encodeSRGB (rgb[j]);
+        }
+
+        const float alpha = c1[3] + (c2[3] - c1[3]) * proportion;
+
+        *entry++ = jlimit (0.0f, 255.0f, rgb[2] * alpha * 255.0f);
+        *entry++ = jlimit (0.0f, 255.0f, rgb[1] * alpha * 255.0f);
+        *entry++ = jlimit (0.0f, 255.0f, rgb[0] * alpha * 255.0f);
+        *entry++ = jlimit (0.0f, 255.0f, alpha * 255.0f);
+    }
+}
+
+void DitheredGradientRenderer::getInterpolatedComponents (const Colour& colour, float* components) const noexcept
+{
+    using namespace DitheredGradientHelpers;
+
+    components[0] = colour.getFloatRed();
+    components[1] = colour.getFloatGreen();
+    components[2] = colour.getFloatBlue();
+    components[3] = colour.getFloatAlpha();
+
+    if (gammaCorrect)
+        for (int i = 0; i < 3; ++i)
+            components[i] = sRGBToLinear (components[i]);
+}
+
+float DitheredGradientRenderer::encodeSRGB (float linearValue) const noexcept
+{
+    const float position = jlimit (0.0f, 1.0f, linearValue) * encodingTableSize;
+    const int index = jmin ((int) position, encodingTableSize - 1);
+    const float v1 = encodingTable[index];
+
+    return v1 + (encodingTable[index + 1] - v1) * (position - index);
+}
@@ -13,31 +13,37 @@
 
 
 //==============================================================================
-class GradientDesigner::ColourPoint :   public Component,
-                                        public ChangeListener
+class GradientDesigner::ColourPoint :   public Component
 {
 public:
     //==============================================================================
-    ColourPoint (GradientDesigner& owner_,
-                 double pointPosition, const Colour& pointColour)
-        : owner (owner_), position (pointPosition), colour (pointColour), draggable (true)
+    ColourPoint (GradientDesigner& owner_)
+        : owner (owner_), index (-1), position (0.0), draggable (false), inUse (false),
+          isHeldByMouse (false)
     {
     }
     
     virtual ~ColourPoint()
     {
     }
+
+    void setStop (int newIndex, double newPosition, const Colour& newColour)
+    {
+        index = newIndex;
+        position = newPosition;
+
+        if (colour != newColour)
+        {
+            colour = newColour;
+            repaint();
+        }
+    }
     
     void paint (Graphics& g)
     {
-        Rectangle<float> bounds (getLocalBounds().toFloat());
-        const float hw = bounds.getWidth() / 2.0f;
+        const float hw = getWidth() / 2.0f;
+        const float right = (float) getWidth();
         Rectangle<int> colourBounds (getLocalBounds().removeFromBottom (getWidth()).reduced (2));
-        
-        Path arrowPath;
-        arrowPath.addTriangle (0.0f, hw + 1,
-                               (float) getWidth(), hw + 1,
-                               (float) getLocalBounds().getCentreX(), 0.0f);
 
         // first draw the arrow and colour squares
         g.setColour (Colours::lightgrey);
@@ -45,7 +51,7 @@ public:
         g.fillRect (colourBounds.translated (1, 1));
 
         g.setColour (Colours::grey);
-        g.drawHorizontalLine (hw, 0.0f, bounds.getRight());
+        g.drawHorizontalLine (hw, 0.0f, right);
 
 
         g.setColour (Colours::white);
@@ -55,39 +61,63 @@ public:
         g.fillRect (colourBounds);
 
         // now draw the black outline
-        Path outline;
-        outline.startNewSubPath (0.0f, hw);
-        outline.lineTo (bounds.getCentreX(), 0.0f);
-        outline.lineTo (bounds.getRight(), hw);
-        
         g.setColour (Colours::black);
         g.strokePath (outline, PathStrokeType (1.0f));
-        g.drawHorizontalLine (getHeight() - 1, 0.0f, bounds.getRight());
-        g.drawVerticalLine (0, hw, bounds.getHeight());
-        g.drawVerticalLine (getWidth() - 1, hw, bounds.getHeight());
+        g.drawHorizontalLine (getHeight() - 1, 0.0f, right);
+        g.drawVerticalLine (0, hw, (float) getHeight());
+        g.drawVerticalLine (getWidth() - 1, hw, (float) getHeight());
+    }
+
+    void resized()
+    {
+        // the paths are only rebuilt here so painting doesn't need to allocate them
+        const float hw = getWidth() / 2.0f;
+
+        arrowPath.clear();
+        arrowPath.addTriangle (0.0f, hw + 1,
+                               (float) getWidth(), hw + 1,
+                               (float) getLocalBounds().getCentreX(), 0.0f);
+
+        outline.clear();
+        outline.startNewSubPath (0.0f, hw);
+        outline.lineTo (getWidth() / 2.0f, 0.0f);
+        outline.lineTo ((float) getWidth(), hw);
     }
     
     void mouseDown (const MouseEvent& e)
     {
         if (e.mods.isPopupMenu())
         {
-            ColourSelector* colourSelector = new ColourSelector();
-            colourSelector->setCurrentColour (colour);
-            colourSelector->addChangeListener (this);
-            colourSelector->setColour (ColourSelector::backgroundColourId, Colours::transparentBlack);
-            colourSelector->setSize (300, 400);
-            
-            CallOutBox::launchAsynchronously (colourSelector, getScreenBounds(), nullptr);
+            owner.showColourPicker (this);
         }
         else if (draggable)
         {
+            owner.draggingPoint = this;
+            isHeldByMouse = true;
             dragger.startDraggingComponent (this, e);
         }
     }
 
+    void mouseUp (const MouseEvent&)
+    {
+        // the marker may have been recycled during the drag, in which case it can
+        // only be handed out again now the mouse has let go of it
+        isHeldByMouse = false;
+
+        if (owner.draggingPoint == this)
+        {
+            // let the point be grouped with its neighbours again
+            owner.draggingPoint = nullptr;
+            owner.updateLayout();
+        }
+    }
+
     void mouseDrag (const MouseEvent& e)
     {
-        if (draggable)
+        // once the stop has been removed the mouse events keep coming here until the
+        // button is released, so make sure they don't affect whatever stop this
+        // marker might have been re-used for
+        if (draggable && owner.draggingPoint == this)
         {
             dragger.dragComponent (this, e, nullptr);
 
@@ -98,104 +128,288 @@ public:
                 owner.removePoint (this);
         }
     }
-
-    void changeListenerCallback (ChangeBroadcaster* source)
-    {
-        ColourSelector* cs = dynamic_cast <ColourSelector*> (source);
-        colour = cs->getCurrentColour();
-        owner.updatePointColour (this);
-    }
     
 private:
     //==============================================================================
     friend class GradientDesigner;
                      
     GradientDesigner& owner;
+    int index;
     double position;
     Colour colour;
-    bool draggable;
+    bool draggable, inUse, isHeldByMouse;
     
     ComponentDragger dragger;
+    Path arrowPath, outline;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ColourPoint);
 };
 
+//==============================================================================
+/** Stands in for a group of stops that are too close together to show separately. */
+class GradientDesigner::ClusterMarker :   public Component
+{
+public:
+    //==============================================================================
+    ClusterMarker (GradientDesigner& owner_)
+        : owner (owner_), firstIndex (0), numStops (0),
+          font (9.0f, Font::bold)
+    {
+    }
+
+    void setStops (int newFirstIndex, int newNumStops)
+    {
+        const GradientModel& model = *owner.model;
+
+        firstIndex = newFirstIndex;
+        range = Range<double> (model.getStopPosition (firstIndex),
+                               model.getStopPosition (firstIndex + newNumStops - 1));
+        firstColour = model.getStopColour (firstIndex);
+        lastColour = model.getStopColour (firstIndex + newNumStops - 1);
+
+        if (numStops != newNumStops)
+        {
+            numStops = newNumStops;
+            countText = String (numStops);
+        }
+
+        repaint();
+    }
+
+    bool containsStop (int index) const noexcept
+    {
+        return index >= firstIndex && index < firstIndex + numStops;
+    }
+
+    void paint (Graphics& g)
+    {
+        const Rectangle<int> colourBounds (0, arrowH, getWidth(), getHeight() - arrowH);
+        const int halfW = colourBounds.getWidth() / 2;
+
+        g.setColour (Colours::lightgrey);
+        g.fillPath (arrowPath);
+
+        // the first and last colours side by side, which is cheaper than a gradient fill
+        g.setColour (firstColour);
+        g.fillRect (colourBounds.getX(), colourBounds.getY(), halfW, colourBounds.getHeight());
+        g.setColour (lastColour);
+        g.fillRect (colourBounds.getX() + halfW, colourBounds.getY(),
+                    colourBounds.getWidth() - halfW, colourBounds.getHeight());
+
+        g.setColour (Colours::black);
+        g.strokePath (arrowPath, PathStrokeType (1.0f));
+        g.drawRect (colourBounds, 1);
+
+        g.setFont (font);
+        g.setColour (firstColour.interpolatedWith (lastColour, 0.5f).contrasting());
+        g.drawText (countText, colourBounds.getX(), colourBounds.getY(),
+                    colourBounds.getWidth(), colourBounds.getHeight(),
+                    Justification::centred, false);
+    }
+
+    void resized()
+    {
+        arrowPath.clear();
+        arrowPath.addTriangle (0.0f, (float) arrowH,
+                               (float) getWidth(), (float) arrowH,
+                               getWidth() / 2.0f, 0.0f);
+    }
+
+    void mouseDown (const MouseEvent& e)
+    {
+        if (! e.mods.isPopupMenu())
+            owner.zoomToCluster (this);
+    }
+
+private:
+    //==============================================================================
+    friend class GradientDesigner;
+
+    enum { arrowH = 6 };
+
+    GradientDesigner& owner;
+    int firstIndex, numStops;
+    Range<double> range;
+    Colour firstColour, lastColour;
+
+    Path arrowPath;
+    Font font;
+    String countText;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ClusterMarker);
+};
+
+//==============================================================================
+namespace GradientDesignerHelpers
+{
+    const int pointW = 12;
+    const int pointH = 18;
+
+    /** The smallest range of positions that can be zoomed in to. At this level
+        stops are never grouped together as there's no way to zoom further.
+     */
+    const double minVisibleLength = 1.0e-6;
+}
 
 //==============================================================================
 GradientDesigner::GradientDesigner (const ColourGradient& sourceGradient)
-    : gradient  (sourceGradient), isResizing (false)
+    : model (new GradientModel (sourceGradient)),
+      draggingPoint (nullptr),
+      pickerPoint (nullptr),
+      visibleRange (0.0, 1.0),
+      isResizing (false)
 {
-    setGradient (sourceGradient);
+    initialise();
+}
+
+GradientDesigner::GradientDesigner (GradientModel* modelToUse)
+    : model (modelToUse),
+      draggingPoint (nullptr),
+      pickerPoint (nullptr),
+      visibleRange (0.0, 1.0),
+      isResizing (false)
+{
+    jassert (modelToUse != nullptr);
+
+    initialise();
 }
 
 GradientDesigner::~GradientDesigner()
 {
+    colourSelector.removeChangeListener (this);
+    model->removeListener (this);
+}
+
+void GradientDesigner::initialise()
+{
+    colourSelector.setColour (ColourSelector::backgroundColourId, Colours::transparentBlack);
+    colourSelector.setSize (300, 400);
+    colourSelector.addChangeListener (this);
+
+    model->addListener (this);
+    updateLayout();
 }
 
 void GradientDesigner::setGradient (const ColourGradient& newGradient)
 {
-    jassert (newGradient.getNumColours() >= 2); // this needs to be an initialised gradient!
+    model->setGradient (newGradient);
+}
+
+const ColourGradient& GradientDesigner::getGradient() const
+{
+    return model->getGradient();
+}
 
-    points.clear();
-    gradient.clearColours();
-    
-    for (int i = 0; i < newGradient.getNumColours(); ++i)
-        addPoint (newGradient.getColourPosition (i), newGradient.getColour (i));
-    
-    points.getFirst()->draggable = false;
-    points.getLast()->draggable = false;
+//==============================================================================
+bool GradientDesigner::publishToSharedMemory (const String& segmentName, int maxNumStops)
+{
+    // the old segment has to go first in case it has the same name
+    publisher = nullptr;
+    publisher = new SharedGradientPublisher (*model, maxNumStops);
+
+    if (publisher->start (segmentName))
+        return true;
+
+    publisher = nullptr;
+    return false;
+}
 
-    resized();
+void GradientDesigner::stopPublishing()
+{
+    publisher = nullptr;
+}
+
+//==============================================================================
+void GradientDesigner::setDitheredPreview (bool shouldDither, bool gammaCorrect)
+{
+    previewCache.setDithering (shouldDither, gammaCorrect);
     repaint();
 }
 
-const ColourGradient& GradientDesigner::getGradient()
+//==============================================================================
+void GradientDesigner::setVisibleRange (Range<double> newRange)
 {
-    return gradient;
+    using namespace GradientDesignerHelpers;
+
+    const double length = jlimit (minVisibleLength, 1.0, newRange.getLength());
+    newRange = Range<double> (jlimit (0.0, 1.0 - length, newRange.getStart()), 0.0).withLength (length);
+
+    if (newRange != visibleRange)
+    {
+        visibleRange = newRange;
+
+        updateLayout();
+        repaint();
+    }
 }
 
+//==============================================================================
 void GradientDesigner::paint (Graphics& g)
 {
-    ColourGradient previewGradient (gradient);
-    previewGradient.point1 = previewArea.getTopLeft().toFloat();
-    previewGradient.point2 = previewArea.getTopRight().toFloat();
-    previewGradient.isRadial = false;
-
     g.fillAll (Colours::white);
     g.fillCheckerBoard (previewArea, 10, 10, Colour (0xffdddddd), Colour (0xffffffff));
 
-    g.setGradientFill (previewGradient);
-    g.fillRect (previewArea);
+    previewCache.draw (g, *model, previewArea, false, GradientImageCache::getScaleFactorFor (*this), visibleRange);
     
     g.setColour (Colours::grey);
     g.drawRect (previewArea, 1);
+
+    // when zoomed in show where the visible range is within the whole gradient
+    if (visibleRange.getLength() < 1.0)
+    {
+        const Rectangle<int> overviewArea (previewArea.getX(), pointsArea.getBottom() + 4, previewArea.getWidth(), 4);
+        const int x1 = overviewArea.getX() + roundToInt (visibleRange.getStart() * overviewArea.getWidth());
+        const int x2 = overviewArea.getX() + roundToInt (visibleRange.getEnd() * overviewArea.getWidth());
+
+        g.setColour (Colours::lightgrey);
+        g.fillRect (overviewArea);
+        g.setColour (Colours::grey);
+        g.fillRect (x1, overviewArea.getY(), jmax (1, x2 - x1), overviewArea.getHeight());
+    }
 }
 
 void GradientDesigner::resized()
 {
-    const int pointW = 12;
-    const int pointH = 18;
-    
-    ScopedValueSetter<bool> setter (isResizing, true);
+    using namespace GradientDesignerHelpers;
 
     previewArea = getLocalBounds().reduced (pointW).withY (10).withHeight (getHeight() / 2);
     pointsArea = previewArea.withHeight (pointH).translated (0, previewArea.getHeight());
     
-    for (int i = 0; i < points.size(); ++i)
-    {
-        ColourPoint* point = points.getUnchecked (i);
-        
-        if (point != nullptr)
-            point->setBounds (previewArea.getX() + (previewArea.getWidth() + 2) * point->position - (pointW / 2), previewArea.getBottom(), pointW, pointH);
-    }
+    updateLayout();
 }
 
 void GradientDesigner::mouseDown (const MouseEvent& e)
 {
     if (pointsArea.contains (e.getMouseDownPosition()))
     {
-        const double position = (e.getMouseDownX() - previewArea.getX()) / (double) (previewArea.getWidth() + 2);
-        addPoint (position, gradient.getColourAtPosition (position));
+        const double position = xToPosition (e.getMouseDownX());
+        addPoint (position, model->getColourAtPosition (position));
+    }
+}
+
+void GradientDesigner::mouseDoubleClick (const MouseEvent& e)
+{
+    if (previewArea.contains (e.getMouseDownPosition()))
+        setVisibleRange (Range<double> (0.0, 1.0));
+}
+
+void GradientDesigner::mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel)
+{
+    const double length = visibleRange.getLength();
+
+    if (wheel.deltaX != 0 || e.mods.isShiftDown())
+    {
+        const double delta = wheel.deltaX != 0 ? wheel.deltaX : wheel.deltaY;
+        setVisibleRange (visibleRange - delta * length);
+    }
+    else
+    {
+        // zoom around the position under the mouse
+        const double anchor = xToPosition (e.x);
+        const double newLength = length * jlimit (0.25, 4.0, 1.0 - wheel.deltaY);
+
+        setVisibleRange (Range<double> (anchor - (anchor - visibleRange.getStart()) * newLength / length, 0.0)
+                            .withLength (newLength));
     }
 }
 
@@ -214,83 +428,334 @@ void GradientDesigner::componentMovedOrResized (Component& component,
                 if (constrainPointBounds (point))
                     return;
                 
-                const double newPosition = (point->getBounds().getCentreX() - previewArea.getX()) / (double) (previewArea.getWidth() + 2);
+                const double newPosition = xToPosition (point->getBounds().getCentreX());
 
-                point->position = newPosition;
-                gradient.removeColour (i);
-                const int newIndex = addColour (newPosition, point->colour);
+                // the model will call back and update the layout for us
+                model->moveStop (point->index, newPosition);
 
-                points.move (i, newIndex);
-                
-                repaint();
+                break;
             }
         }
     }
 }
 
+void GradientDesigner::changeListenerCallback (ChangeBroadcaster* source)
+{
+    if (source == &colourSelector && pickerPoint != nullptr)
+    {
+        pickerPoint->colour = colourSelector.getCurrentColour();
+        updatePointColour (pickerPoint);
+    }
+}
+
 //==============================================================================
-int GradientDesigner::addColour (double position, const Colour& colour)
+void GradientDesigner::gradientStopAdded (GradientModel* /*model*/, int index)
 {
-    const int newIndex = gradient.addColour (position, colour);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        ColourPoint* point = points.getUnchecked (i);
 
-    sendChangeMessage();
-    
-    return newIndex;
+        if (point->index >= index)
+            ++(point->index);
+    }
+
+    updateLayout();
+    repaint();
 }
 
-void GradientDesigner::setColour (int index, const Colour& colour)
+void GradientDesigner::gradientStopRemoved (GradientModel* /*model*/, int index)
 {
-    gradient.setColour (index, colour);
-    
-    sendChangeMessage();
+    for (int i = 0; i < points.size(); ++i)
+    {
+        ColourPoint* point = points.getUnchecked (i);
+
+        if (point->index == index)
+        {
+            if (draggingPoint == point)
+                draggingPoint = nullptr;
+
+            point->index = -1; // this will get recycled by updateLayout()
+        }
+        else if (point->index > index)
+            --(point->index);
+    }
+
+    updateLayout();
+    repaint();
 }
 
-void GradientDesigner::removeColour (int index)
+void GradientDesigner::gradientStopMoved (GradientModel* /*model*/, int oldIndex, int newIndex)
 {
-    gradient.removeColour (index);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        ColourPoint* point = points.getUnchecked (i);
 
-    sendChangeMessage();
+        if (point->index == oldIndex)
+            point->index = newIndex;
+        else if (oldIndex < newIndex && point->index > oldIndex && point->index <= newIndex)
+            --(point->index);
+        else if (newIndex < oldIndex && point->index >= newIndex && point->index < oldIndex)
+            ++(point->index);
+    }
+
+    updateLayout();
+    repaint();
 }
 
-//==============================================================================
-void GradientDesigner::addPoint (double position, const Colour& colour)
+void GradientDesigner::gradientStopColourChanged (GradientModel* /*model*/, int index)
 {
-    ColourPoint* newPoint = new ColourPoint (*this, position, colour);
-    addAndMakeVisible (newPoint);
-    
-    const int newIndex = addColour (position, colour);
-    points.insert (newIndex, newPoint);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        ColourPoint* point = points.getUnchecked (i);
+
+        if (point->index == index)
+            point->setStop (index, point->position, model->getStopColour (index));
+    }
+
+    for (int i = 0; i < clusters.size(); ++i)
+    {
+        ClusterMarker* cluster = clusters.getUnchecked (i);
+
+        if (cluster->isVisible() && cluster->containsStop (index))
+            cluster->setStops (cluster->firstIndex, cluster->numStops);
+    }
 
-    resized();
     repaint();
+}
 
-    newPoint->addComponentListener (this);
+void GradientDesigner::gradientReset (GradientModel* /*model*/)
+{
+    recycleAllPoints();
+    updateLayout();
+    repaint();
+}
+
+void GradientDesigner::gradientChanged (GradientModel* /*model*/)
+{
+    sendChangeMessage();
+}
+
+//==============================================================================
+void GradientDesigner::addPoint (double position, const Colour& colour)
+{
+    model->addStop (position, colour);
 }
 
 void GradientDesigner::removePoint (ColourPoint* pointToRemove)
 {
-    const int index = points.indexOf (pointToRemove);
-    removeColour (index);
-    points.remove (index);
-    
-    resized();
-    repaint();
+    if (pointToRemove->index >= 0)
+        model->removeStop (pointToRemove->index);
 }
 
 void GradientDesigner::updatePointColour (ColourPoint* pointToChange)
 {
-    for (int i = 0; i < points.size(); ++i)
+    if (pointToChange->index >= 0)
+        model->setStopColour (pointToChange->index, pointToChange->colour);
+}
+
+void GradientDesigner::zoomToCluster (ClusterMarker* cluster)
+{
+    using namespace GradientDesignerHelpers;
+
+    // zoom in far enough that the stops are spaced out by about a marker's width,
+    // and always by at least a factor of two so that repeated clicks will get there
+    const double targetWidth = jmin ((double) previewArea.getWidth(), 2.0 * pointW * cluster->numStops);
+    const double newLength = jmin (visibleRange.getLength() / 2.0,
+                                   cluster->range.getLength() * previewArea.getWidth() / targetWidth);
+
+    setVisibleRange (Range<double> (cluster->range.getStart() + cluster->range.getLength() / 2.0 - newLength / 2.0, 0.0)
+                        .withLength (newLength));
+}
+
+void GradientDesigner::showColourPicker (ColourPoint* point)
+{
+    pickerPoint = point;
+    colourSelector.setCurrentColour (point->colour);
+
+    // the call-out is created once and then just moved and shown again each time
+    if (colourPickerBox == nullptr)
+    {
+        colourPickerBox = new CallOutBox (colourSelector, point->getScreenBounds(), nullptr);
+    }
+    else
+    {
+        colourPickerBox->updatePosition (point->getScreenBounds(),
+                                         Desktop::getInstance().getDisplays()
+                                            .getDisplayContaining (point->getScreenBounds().getCentre()).userArea);
+        colourPickerBox->setVisible (true);
+    }
+
+    colourPickerBox->enterModalState (true);
+}
+
+//==============================================================================
+void GradientDesigner::updateLayout()
+{
+    using namespace GradientDesignerHelpers;
+
+    ScopedValueSetter<bool> setter (isResizing, true);
+
+    sortPointsByIndex();
+    layoutPoints.clearQuick();
+    int nextPoint = 0;
+
+    const int numStops = model->getNumStops();
+    const int endIndex = model->findFirstStopAfter (visibleRange.getEnd());
+    const int draggedIndex = draggingPoint != nullptr ? draggingPoint->index : -1;
+    const bool canCluster = visibleRange.getLength() > minVisibleLength * 1.01;
+    int numClustersUsed = 0;
+
+    for (int i = model->findFirstStopAtOrAfter (visibleRange.getStart()); i < endIndex;)
     {
-        ColourPoint* point = points[i];
-        
-        if (point == pointToChange)
+        // find all the stops that would overlap this one, these become a cluster
+        int groupEnd = i + 1;
+
+        if (canCluster && i != draggedIndex)
         {
-            setColour (i, point->colour);
-            repaint();
+            const double groupEndPosition = xToPosition (positionToX (model->getStopPosition (i)) + pointW);
+            groupEnd = jlimit (i + 1, endIndex, model->findFirstStopAtOrAfter (groupEndPosition, i + 1));
+
+            // the point being dragged always needs its own marker
+            if (draggedIndex > i && draggedIndex < groupEnd)
+                groupEnd = draggedIndex;
+        }
+
+        if (groupEnd - i == 1)
+        {
+            // points that are no longer needed come first as the array is sorted
+            while (nextPoint < points.size() && points.getUnchecked (nextPoint)->index < i)
+                recyclePoint (points.getUnchecked (nextPoint++));
+
+            ColourPoint* point;
+
+            if (nextPoint < points.size() && points.getUnchecked (nextPoint)->index == i)
+                point = points.getUnchecked (nextPoint++);
+            else
+                point = getFreePoint();
+
+            point->setStop (i, model->getStopPosition (i), model->getStopColour (i));
+            point->draggable = (i > 0 && i < numStops - 1); // the end points are always fixed
+            updatePointBounds (point);
+            point->setVisible (true);
 
-            break;
+            layoutPoints.add (point);
         }
+        else
+        {
+            ClusterMarker* cluster = clusters[numClustersUsed];
+
+            if (cluster == nullptr)
+            {
+                cluster = new ClusterMarker (*this);
+                clusters.add (cluster);
+                addChildComponent (cluster);
+            }
+
+            cluster->setStops (i, groupEnd - i);
+
+            const int x1 = positionToX (cluster->range.getStart()) - pointW / 2;
+            const int x2 = positionToX (cluster->range.getEnd()) + pointW / 2;
+            cluster->setBounds (x1, previewArea.getBottom(), jmax (pointW, x2 - x1), pointH);
+            cluster->setVisible (true);
+
+            ++numClustersUsed;
+        }
+
+        i = groupEnd;
     }
+
+    while (nextPoint < points.size())
+        recyclePoint (points.getUnchecked (nextPoint++));
+
+    // swapping keeps both arrays' storage around for next time
+    points.swapWithArray (layoutPoints);
+    layoutPoints.clearQuick();
+
+    for (int i = numClustersUsed; i < clusters.size(); ++i)
+        clusters.getUnchecked (i)->setVisible (false);
+}
+
+void GradientDesigner::sortPointsByIndex()
+{
+    // at most one point will be out of order after a stop has moved
+    for (int i = 1; i < points.size(); ++i)
+    {
+        const int index = points.getUnchecked (i)->index;
+        int j = i;
+
+        while (j > 0 && points.getUnchecked (j - 1)->index > index)
+            --j;
+
+        if (j != i)
+            points.move (i, j);
+    }
+}
+
+GradientDesigner::ColourPoint* GradientDesigner::getFreePoint()
+{
+    for (int i = 0; i < pointPool.size(); ++i)
+    {
+        ColourPoint* point = pointPool.getUnchecked (i);
+
+        if (! (point->inUse || point->isHeldByMouse))
+        {
+            point->inUse = true;
+            return point;
+        }
+    }
+
+    ColourPoint* newPoint = new ColourPoint (*this);
+    pointPool.add (newPoint);
+    addChildComponent (newPoint);
+    newPoint->addComponentListener (this);
+    newPoint->inUse = true;
+
+    return newPoint;
+}
+
+void GradientDesigner::recyclePoint (ColourPoint* point)
+{
+    point->setVisible (false);
+    point->index = -1;
+    point->draggable = false;
+    point->inUse = false;
+
+    if (pickerPoint == point)
+        pickerPoint = nullptr;
+
+    if (draggingPoint == point)
+        draggingPoint = nullptr;
+}
+
+void GradientDesigner::recycleAllPoints()
+{
+    for (int i = 0; i < points.size(); ++i)
+        recyclePoint (points.getUnchecked (i));
+
+    points.clearQuick();
+}
+
+//==============================================================================
+int GradientDesigner::positionToX (double position) const
+{
+    return previewArea.getX() + roundToInt ((position - visibleRange.getStart()) * (previewArea.getWidth() + 2)
+                                              / visibleRange.getLength());
+}
+
+double GradientDesigner::xToPosition (int x) const
+{
+    return visibleRange.getStart() + (x - previewArea.getX()) * visibleRange.getLength()
+                                        / (double) (previewArea.getWidth() + 2);
+}
+
+void GradientDesigner::updatePointBounds (ColourPoint* point)
+{
+    using namespace GradientDesignerHelpers;
+
+    ScopedValueSetter<bool> setter (isResizing, true);
+
+    point->setBounds (positionToX (point->position) - (pointW / 2),
+                      previewArea.getBottom(), pointW, pointH);
 }
 
 bool GradientDesigner::constrainPointBounds (ColourPoint* point)
@@ -12,6 +12,9 @@
 #define __GRADIENTDESIGNER_H_28D37715__
 
 #include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientModel.h"
+#include "GradientImageCache.h"
+#include "SharedGradientPublisher.h"
 
 
 //==============================================================================
@@ -23,15 +26,29 @@
     Right-clicking on a marker will show a colour selector, dragging a marker
     up or down will remove it. Click in the space just below the display to add
     new markers.
+
+    Use the mouse wheel to zoom in around the mouse position and a horizontal or
+    shift-wheel to pan. Only the markers inside the visible range are created and
+    markers that would overlap are grouped into cluster markers showing how many
+    stops they contain. Clicking a cluster zooms in on it and double-clicking the
+    display zooms back out.
+
+    Markers are kept in a pool and reused as stops come and go, and a single colour
+    selector is shared between all of them, so once everything has been created
+    dragging, recolouring, adding and removing stops won't allocate any memory.
  
-    The designer keeps its own internal copy of the gradient displayed and you
-    can be notified of changes to this by registering as ChangeListener.
+    The gradient being edited lives in a GradientModel which can be shared with
+    other designers and previews. Register as a GradientModel::Listener to be
+    told precisely what changed, or as a ChangeListener to the designer if you
+    just need to know that something did.
  
-    @see ColourGradient, ChangeListener
+    @see GradientModel, ColourGradient, ChangeListener
  */
 class GradientDesigner    : public Component,
                             public ComponentListener,
-                            public ChangeBroadcaster
+                            public ChangeBroadcaster,
+                            public ChangeListener,
+                            public GradientModel::Listener
 {
 public:
     //==============================================================================
@@ -44,6 +61,14 @@ public:
                             valid gradient i.e. have it's start and end colours set.
      */
     GradientDesigner (const ColourGradient& gradient);
+
+    /** Creates a designer that edits a shared model.
+        Any other designers or views attached to the model will be kept in sync
+        with changes made here and vice versa.
+
+        @param modelToUse   The model to edit. This must not be null.
+     */
+    GradientDesigner (GradientModel* modelToUse);
     
     /** Destructor. */
     ~GradientDesigner();
@@ -58,7 +83,45 @@ public:
     
     /** Returns the gradient currently represented by the designer.
      */
-    const ColourGradient& getGradient();
+    const ColourGradient& getGradient() const;
+
+    /** Returns the model being edited.
+        You can pass this to other designers to have them edit the same gradient.
+     */
+    GradientModel* getModel() const noexcept        { return model; }
+
+    //==============================================================================
+    /** Starts publishing the gradient to a named POSIX shared memory segment.
+        Other processes can then use a SharedGradientReader to pick up edits as they
+        are made. Calling this again with a different name will move the segment.
+
+        @param segmentName  The name of the segment, starting with a slash
+        @param maxNumStops  The number of stops to make room for to begin with. If
+                            the gradient grows past this the segment is re-created
+                            with more room, so readers have to open it again.
+        @returns true if the segment could be created
+        @see SharedGradientPublisher
+     */
+    bool publishToSharedMemory (const String& segmentName, int maxNumStops = 1024);
+
+    /** Stops publishing the gradient and removes the shared memory segment. */
+    void stopPublishing();
+
+    //==============================================================================
+    /** Sets whether the preview is drawn with dithering to avoid banding, and
+        whether its colours are interpolated in linear light.
+        @see GradientImageCache::setDithering
+     */
+    void setDitheredPreview (bool shouldDither, bool gammaCorrect);
+
+    //==============================================================================
+    /** Sets the range of gradient positions shown, zooming in or out.
+        The range will be constrained to lie within 0 and 1.
+     */
+    void setVisibleRange (Range<double> newRange);
+
+    /** Returns the range of gradient positions currently shown. */
+    const Range<double>& getVisibleRange() const noexcept   { return visibleRange; }
     
     //==============================================================================
     /** @internal */
@@ -69,32 +132,79 @@ public:
 
     /** @internal */
     void mouseDown (const MouseEvent& e);
+
+    /** @internal */
+    void mouseDoubleClick (const MouseEvent& e);
+
+    /** @internal */
+    void mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel);
     
     /** @internal */
     void componentMovedOrResized (Component& component,
                                   bool wasMoved,
                                   bool wasResized);
+
+    /** @internal */
+    void changeListenerCallback (ChangeBroadcaster* source);
+
+    /** @internal */
+    void gradientStopAdded (GradientModel* model, int index);
+
+    /** @internal */
+    void gradientStopRemoved (GradientModel* model, int index);
+
+    /** @internal */
+    void gradientStopMoved (GradientModel* model, int oldIndex, int newIndex);
+
+    /** @internal */
+    void gradientStopColourChanged (GradientModel* model, int index);
+
+    /** @internal */
+    void gradientReset (GradientModel* model);
+
+    /** @internal */
+    void gradientChanged (GradientModel* model);
     
 private:
     //==============================================================================
     class ColourPoint;
+    class ClusterMarker;
     friend class ColourPoint;
+    friend class ClusterMarker;
 
-    ColourGradient gradient;
-    OwnedArray<ColourPoint> points;
+    GradientModel::Ptr model;
+    OwnedArray<ColourPoint> pointPool;
+    Array<ColourPoint*> points, layoutPoints;
+    OwnedArray<ClusterMarker> clusters;
+    ColourPoint* draggingPoint;
+    ColourSelector colourSelector;
+    ScopedPointer<CallOutBox> colourPickerBox;
+    ColourPoint* pickerPoint;
+    GradientImageCache previewCache;
+    ScopedPointer<SharedGradientPublisher> publisher;
     Rectangle<int> previewArea, pointsArea;
+    Range<double> visibleRange;
     bool isResizing;
 
     //==============================================================================
-    int addColour (double position, const Colour& colour);
-    void setColour (int index, const Colour& colour);
-    void removeColour (int index);
-    
-    //==============================================================================
+    void initialise();
     void addPoint (double position, const Colour& colour);
     void removePoint (ColourPoint* pointToRemove);
     void updatePointColour (ColourPoint* pointToChange);
+    void zoomToCluster (ClusterMarker* cluster);
+    void showColourPicker (ColourPoint* point);
+
+    //==============================================================================
+    void updateLayout();
+    void sortPointsByIndex();
+    ColourPoint* getFreePoint();
+    void recyclePoint (ColourPoint* point);
+    void recycleAllPoints();
+
+    int positionToX (double position) const;
+    double xToPosition (int x) const;
 
+    void updatePointBounds (ColourPoint* point);
     bool constrainPointBounds (ColourPoint* point);
     
     //==============================================================================
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    GradientImageCache.cpp
+    Created: 19 Oct 2026 4:41:46am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientImageCache.h"
+
+
+//==============================================================================
+GradientImageCache::GradientImageCache (int maxNumImages_)
+    : maxNumImages (jmax (1, maxNumImages_)), useCounter (0)
+{
+    renderer.setDithering (false);
+}
+
+GradientImageCache::~GradientImageCache()
+{
+}
+
+//==============================================================================
+void GradientImageCache::draw (Graphics& g, const GradientModel& model,
+                               const Rectangle<int>& area, bool isRadial, float scale,
+                               const Range<double>& range)
+{
+    if (area.isEmpty())
+        return;
+
+    const Image& image = getImage (model, area.getWidth(), area.getHeight(), isRadial, scale, range);
+
+    g.drawImage (image,
+                 area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                 0, 0, image.getWidth(), image.getHeight());
+}
+
+const Image& GradientImageCache::getImage (const GradientModel& model,
+                                           int width, int height, bool isRadial, float scale,
+                                           const Range<double>& range)
+{
+    CachedImage* cachedImage = findOrCreateImageForScale (scale, isRadial);
+    cachedImage->lastUsed = ++useCounter;
+
+    if (cachedImage->model != &model
+         || cachedImage->version != model.getVersion()
+         || cachedImage->width != width
+         || cachedImage->height != height
+         || (! isRadial && cachedImage->range != range)
+         || cachedImage->image.isNull())
+    {
+        cachedImage->model = &model;
+        cachedImage->version = model.getVersion();
+        cachedImage->width = width;
+        cachedImage->height = height;
+        cachedImage->range = range;
+
+        renderImage (*cachedImage);
+    }
+
+    return cachedImage->image;
+}
+
+void GradientImageCache::clear()
+{
+    images.clear();
+}
+
+void GradientImageCache::setDithering (bool shouldDither, bool gammaCorrect)
+{
+    if (renderer.isDithering() != shouldDither || renderer.isGammaCorrect() != gammaCorrect)
+    {
+        renderer.setDithering (shouldDither);
+        renderer.setGammaCorrect (gammaCorrect);
+        clear();
+    }
+}
+
+//==============================================================================
+float GradientImageCache::getScaleFactorFor (Component& component)
+{
+    if (! component.isShowing())
+        return 1.0f;
+
+    return (float) Desktop::getInstance().getDisplays()
+                     .getDisplayContaining (component.getScreenBounds().getCentre()).scale;
+}
+
+//==============================================================================
+GradientImageCache::CachedImage* GradientImageCache::findOrCreateImageForScale (float scale, bool isRadial)
+{
+    CachedImage* leastRecentlyUsed = nullptr;
+
+    for (int i = 0; i < images.size(); ++i)
+    {
+        CachedImage* cachedImage = images.getUnchecked (i);
+
+        if (cachedImage->scale == scale && cachedImage->isRadial == isRadial)
+            return cachedImage;
+
+        if (leastRecentlyUsed == nullptr || cachedImage->lastUsed < leastRecentlyUsed->lastUsed)
+            leastRecentlyUsed = cachedImage;
+    }
+
+    CachedImage* cachedImage = leastRecentlyUsed;
+
+    if (images.size() < maxNumImages)
+        images.add (cachedImage = new CachedImage());
+
+    cachedImage->model = nullptr;
+    cachedImage->scale = scale;
+    cachedImage->width = cachedImage->height = 0;
+    cachedImage->isRadial = isRadial;
+    cachedImage->version = 0;
+    cachedImage->lastUsed = 0;
+    cachedImage->image = Image::null;
+
+    return cachedImage;
+}
+
+void GradientImageCache::renderImage (CachedImage& cachedImage)
+{
+    const int w = jmax (1, roundToInt (cachedImage.width * cachedImage.scale));
+    const int h = jmax (1, roundToInt (cachedImage.height * cachedImage.scale));
+
+    // re-use the existing pixels when only the gradient has changed
+    if (cachedImage.image.getWidth() != w || cachedImage.image.getHeight() != h)
+        cachedImage.image = Image (Image::ARGB, w, h, false);
+
+    // this reads just the stops in range straight from the model and writes every
+    // pixel, so neither a ColourGradient nor clearing the image is needed. Zooming
+    // in re-scales the stops that are in range rather than stretching the whole
+    // gradient way beyond the image, which would lose precision.
+    renderer.render (*cachedImage.model,
+                     cachedImage.isRadial ? Range<double> (0.0, 1.0) : cachedImage.range,
+                     cachedImage.isRadial, cachedImage.image);
+}
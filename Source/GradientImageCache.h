@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    GradientImageCache.h
+    Created: 19 Oct 2026 4:41:46am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __GRADIENTIMAGECACHE_H_93C0A7F1__
+#define __GRADIENTIMAGECACHE_H_93C0A7F1__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientModel.h"
+#include "DitheredGradientRenderer.h"
+
+
+//==============================================================================
+/**
+    Renders a GradientModel into images at the physical pixel density of the
+    display and keeps them around until the gradient or size changes.
+
+    A separate image is kept for each display scale so moving a window between a
+    normal and a high resolution monitor doesn't cause the gradient to be
+    re-rendered every time it crosses over. Once the cache is full the least
+    recently used image is thrown away.
+
+    @see GradientModel
+ */
+class GradientImageCache
+{
+public:
+    //==============================================================================
+    /** Creates an empty cache.
+
+        @param maxNumImages     The maximum number of different scales to keep
+                                images for at once.
+     */
+    GradientImageCache (int maxNumImages = 4);
+
+    /** Destructor. */
+    ~GradientImageCache();
+
+    //==============================================================================
+    /** Fills an area of a Graphics context with the gradient.
+        This will use a cached image if there is an up to date one for this size and
+        scale, otherwise it will render a new one.
+
+        @param g            The context to draw to
+        @param model        The gradient to draw
+        @param area         The area to fill, in logical coordinates
+        @param isRadial     Whether to draw a linear gradient from left to right
+                            or a radial one from the top-left to the bottom-right
+        @param scale        The number of physical pixels per logical pixel
+        @param range        For linear gradients, the range of gradient positions
+                            to stretch across the area
+     */
+    void draw (Graphics& g, const GradientModel& model,
+               const Rectangle<int>& area, bool isRadial, float scale,
+               const Range<double>& range = Range<double> (0.0, 1.0));
+
+    /** Returns an image of the gradient at the given logical size and scale.
+        The image will be width * scale by height * scale pixels.
+     */
+    const Image& getImage (const GradientModel& model,
+                           int width, int height, bool isRadial, float scale,
+                           const Range<double>& range = Range<double> (0.0, 1.0));
+
+    /** Throws away all the cached images. */
+    void clear();
+
+    /** Sets whether images should be dithered rather than having their colours
+        rounded, and whether colours are interpolated in linear light. Dithering
+        removes any banding at the cost of a slightly noisy looking image up close.
+        The two settings are independent of each other.
+
+        @param shouldDither     Whether to use higher precision, dithered rendering
+        @param gammaCorrect     Whether to interpolate colours in linear light
+                                rather than sRGB
+        @see DitheredGradientRenderer
+     */
+    void setDithering (bool shouldDither, bool gammaCorrect);
+
+    //==============================================================================
+    /** Returns the scale factor of the display that a component is mostly on. */
+    static float getScaleFactorFor (Component& component);
+
+private:
+    //==============================================================================
+    struct CachedImage
+    {
+        const GradientModel* model;
+        float scale;
+        int width, height;
+        bool isRadial;
+        uint32 version, lastUsed;
+        Range<double> range;
+        Image image;
+    };
+
+    OwnedArray<CachedImage> images;
+    const int maxNumImages;
+    uint32 useCounter;
+
+    DitheredGradientRenderer renderer;
+
+    CachedImage* findOrCreateImageForScale (float scale, bool isRadial);
+    void renderImage (CachedImage& cachedImage);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GradientImageCache);
+};
+
+
+#endif  // __GRADIENTIMAGECACHE_H_93C0A7F1__
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    GradientModel.cpp
+    Created: 19 Oct 2026 4:40:51am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientModel.h"
+
+
+//==============================================================================
+GradientModel::GradientModel (const ColourGradient& sourceGradient)
+    : numStops (0), numAllocated (0), version (0),
+      gradient (sourceGradient), gradientVersion (0)
+{
+    jassert (sourceGradient.getNumColours() >= 2); // this needs to be an initialised gradient!
+
+    ensureStorageAllocated (sourceGradient.getNumColours());
+
+    for (int i = 0; i < sourceGradient.getNumColours(); ++i)
+        insertStop (sourceGradient.getColourPosition (i), sourceGradient.getColour (i));
+}
+
+GradientModel::~GradientModel()
+{
+}
+
+void GradientModel::setGradient (const ColourGradient& newGradient)
+{
+    jassert (newGradient.getNumColours() >= 2); // this needs to be an initialised gradient!
+
+    ensureStorageAllocated (newGradient.getNumColours());
+    numStops = 0;
+
+    for (int i = 0; i < newGradient.getNumColours(); ++i)
+        insertStop (newGradient.getColourPosition (i), newGradient.getColour (i));
+
+    ++version;
+    gradient = newGradient;
+    gradientVersion = version;
+
+    listeners.call (&Listener::gradientReset, this);
+    listeners.call (&Listener::gradientChanged, this);
+}
+
+const ColourGradient& GradientModel::getGradient() const
+{
+    if (gradientVersion != version)
+    {
+        gradient.clearColours();
+
+        for (int i = 0; i < numStops; ++i)
+            gradient.addColour (stops[i].position, stops[i].colour);
+
+        gradientVersion = version;
+    }
+
+    return gradient;
+}
+
+const Colour GradientModel::getColourAtPosition (double position) const noexcept
+{
+    if (numStops == 0 || position <= stops[0].position)
+        return numStops > 0 ? stops[0].colour : Colour();
+
+    const int index = findFirstStopAfter (position);
+
+    if (index >= numStops)
+        return stops[numStops - 1].colour;
+
+    const Stop& s1 = stops[index - 1];
+    const Stop& s2 = stops[index];
+
+    return s1.colour.interpolatedWith (s2.colour, (float) ((position - s1.position) / (s2.position - s1.position)));
+}
+
+int GradientModel::findFirstStopAfter (double position) const noexcept
+{
+    int start = 0, end = numStops;
+
+    while (start < end)
+    {
+        const int mid = (start + end) / 2;
+
+        if (stops[mid].position <= position)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
+int GradientModel::findFirstStopAtOrAfter (double position, int startIndex) const noexcept
+{
+    jassert (startIndex >= 0);
+
+    int start = startIndex, end = numStops;
+
+    while (start < end)
+    {
+        const int mid = (start + end) / 2;
+
+        if (stops[mid].position < position)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
+void GradientModel::ensureStorageAllocated (int minNumStops)
+{
+    if (minNumStops > numAllocated)
+    {
+        numAllocated = jmax (minNumStops, numAllocated * 2, 8);
+        stops.realloc ((size_t) numAllocated);
+    }
+}
+
+//==============================================================================
+int GradientModel::addStop (double position, const Colour& colour)
+{
+    const int newIndex = insertStop (position, colour);
+
+    ++version;
+
+    listeners.call (&Listener::gradientStopAdded, this, newIndex);
+    listeners.call (&Listener::gradientChanged, this);
+
+    return newIndex;
+}
+
+void GradientModel::removeStop (int index)
+{
+    jassert (isPositiveAndBelow (index, numStops));
+
+    eraseStop (index);
+
+    ++version;
+
+    listeners.call (&Listener::gradientStopRemoved, this, index);
+    listeners.call (&Listener::gradientChanged, this);
+}
+
+int GradientModel::moveStop (int index, double newPosition)
+{
+    jassert (isPositiveAndBelow (index, numStops));
+
+    // dragging a marker up and down, or snapping it back onto the strip, asks for
+    // the same position again so don't bother anyone when nothing has changed
+    if (jlimit (0.0, 1.0, newPosition) == stops[index].position)
+        return index;
+
+    const Colour colour (stops[index].colour);
+    eraseStop (index);
+    const int newIndex = insertStop (newPosition, colour);
+
+    ++version;
+
+    listeners.call (&Listener::gradientStopMoved, this, index, newIndex);
+    listeners.call (&Listener::gradientChanged, this);
+
+    return newIndex;
+}
+
+void GradientModel::setStopColour (int index, const Colour& newColour)
+{
+    jassert (isPositiveAndBelow (index, numStops));
+
+    if (stops[index].colour != newColour)
+    {
+        stops[index].colour = newColour;
+
+        ++version;
+
+        listeners.call (&Listener::gradientStopColourChanged, this, index);
+        listeners.call (&Listener::gradientChanged, this);
+    }
+}
+
+//==============================================================================
+int GradientModel::insertStop (double position, const Colour& colour)
+{
+    // must be within the two end-points
+    jassert (position >= 0.0 && position <= 1.0);
+    position = jlimit (0.0, 1.0, position);
+
+    ensureStorageAllocated (numStops + 1);
+
+    // like ColourGradient, new stops go after any existing ones at the same position
+    const int index = findFirstStopAfter (position);
+    memmove (stops + index + 1, stops + index, (size_t) (numStops - index) * sizeof (Stop));
+
+    stops[index].position = position;
+    stops[index].colour = colour;
+    ++numStops;
+
+    return index;
+}
+
+void GradientModel::eraseStop (int index) noexcept
+{
+    --numStops;
+    memmove (stops + index, stops + index + 1, (size_t) (numStops - index) * sizeof (Stop));
+}
+
+//==============================================================================
+void GradientModel::addListener (Listener* listener)
+{
+    listeners.add (listener);
+}
+
+void GradientModel::removeListener (Listener* listener)
+{
+    listeners.remove (listener);
+}
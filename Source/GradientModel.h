@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    GradientModel.h
+    Created: 19 Oct 2026 4:40:51am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __GRADIENTMODEL_H_4B1E93A2__
+#define __GRADIENTMODEL_H_4B1E93A2__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+
+//==============================================================================
+/**
+    Holds a colour gradient that can be shared between several editors and previews.
+
+    All changes to the gradient go through this object which then tells its
+    listeners exactly what changed, e.g. which stop was added or moved and to
+    which index. This means views can update just the parts that have changed
+    rather than having to copy and compare the whole gradient on every edit.
+
+    The model is reference counted so any number of GradientDesigners and other
+    views can hold on to the same one.
+
+    The stops are kept in storage that only ever grows, so once it is big enough
+    adding, moving, recolouring and removing stops won't allocate any memory. Use
+    ensureStorageAllocated() to reserve space up front.
+
+    @see GradientDesigner, GradientModel::Listener
+ */
+class GradientModel :   public ReferenceCountedObject
+{
+public:
+    //==============================================================================
+    /** Creates a model holding a copy of a gradient.
+
+        @param gradient     The initial gradient. This must be a valid gradient i.e.
+                            have it's start and end colours set.
+     */
+    GradientModel (const ColourGradient& gradient);
+
+    /** Destructor. */
+    ~GradientModel();
+
+    /** A pointer type to use when sharing a model. */
+    typedef ReferenceCountedObjectPtr<GradientModel> Ptr;
+
+    //==============================================================================
+    /** Replaces the whole gradient.
+        Listeners will receive a gradientReset() callback.
+     */
+    void setGradient (const ColourGradient& newGradient);
+
+    /** Returns the gradient currently held by the model.
+        The gradient's points and radial flag are left as they were last set and
+        should be set by the caller to suit whatever it is drawing.
+
+        The ColourGradient is only rebuilt from the stops when this is called after
+        a change, so prefer the stop methods below where they will do.
+     */
+    const ColourGradient& getGradient() const;
+
+    /** Returns a number that changes every time the gradient is modified.
+        Views can compare this against a stored value to find out whether anything
+        they've cached from the gradient is out of date.
+     */
+    uint32 getVersion() const noexcept                      { return version; }
+
+    //==============================================================================
+    /** Returns the number of stops in the gradient. */
+    int getNumStops() const noexcept                        { return numStops; }
+
+    /** Returns the position of a stop in the range 0 to 1. */
+    double getStopPosition (int index) const noexcept       { jassert (isPositiveAndBelow (index, numStops)); return stops[index].position; }
+
+    /** Returns the colour of a stop. */
+    const Colour getStopColour (int index) const noexcept   { jassert (isPositiveAndBelow (index, numStops)); return stops[index].colour; }
+
+    /** Returns the interpolated colour at a position in the range 0 to 1. */
+    const Colour getColourAtPosition (double position) const noexcept;
+
+    /** Returns the index of the first stop positioned after the given position, or
+        getNumStops() if there isn't one.
+        This is a binary search so it stays cheap however many stops there are.
+     */
+    int findFirstStopAfter (double position) const noexcept;
+
+    /** Returns the index of the first stop at or after the given position, or
+        getNumStops() if there isn't one.
+        Only the stops from startIndex onwards are searched.
+     */
+    int findFirstStopAtOrAfter (double position, int startIndex = 0) const noexcept;
+
+    /** Makes sure there is room for at least this many stops without allocating. */
+    void ensureStorageAllocated (int minNumStops);
+
+    /** Adds a new stop to the gradient, returning the index it was inserted at. */
+    int addStop (double position, const Colour& colour);
+
+    /** Removes a stop from the gradient. */
+    void removeStop (int index);
+
+    /** Moves a stop to a new position, returning the index it ends up at.
+        If the stop is already at that position nothing changes and the listeners
+        aren't called.
+     */
+    int moveStop (int index, double newPosition);
+
+    /** Changes the colour of a stop. */
+    void setStopColour (int index, const Colour& newColour);
+
+    //==============================================================================
+    /**
+        Receives precise callbacks about changes to a GradientModel.
+
+        All callbacks are made synchronously on the thread that changed the model,
+        which should normally be the message thread.
+     */
+    class Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener()  {}
+
+        /** Called after a stop has been inserted at the given index. */
+        virtual void gradientStopAdded (GradientModel* model, int index)                        {}
+
+        /** Called after the stop at the given index has been removed. */
+        virtual void gradientStopRemoved (GradientModel* model, int index)                      {}
+
+        /** Called after a stop has changed position.
+            If the move caused the stop to pass another, newIndex will differ from oldIndex.
+         */
+        virtual void gradientStopMoved (GradientModel* model, int oldIndex, int newIndex)       {}
+
+        /** Called after the colour of a stop has changed. */
+        virtual void gradientStopColourChanged (GradientModel* model, int index)                {}
+
+        /** Called after the whole gradient has been replaced with setGradient(). */
+        virtual void gradientReset (GradientModel* model)                                       {}
+
+        /** Called after any of the more specific callbacks above.
+            Override this if you only need to know that something changed, e.g. to
+            repaint a preview.
+         */
+        virtual void gradientChanged (GradientModel* model)                                     {}
+    };
+
+    /** Registers a listener to receive change callbacks. */
+    void addListener (Listener* listener);
+
+    /** Deregisters a previously added listener. */
+    void removeListener (Listener* listener);
+
+private:
+    //==============================================================================
+    struct Stop
+    {
+        double position;
+        Colour colour;
+    };
+
+    HeapBlock<Stop> stops;
+    int numStops, numAllocated;
+    uint32 version;
+    ListenerList<Listener> listeners;
+
+    mutable ColourGradient gradient;
+    mutable uint32 gradientVersion;
+
+    int insertStop (double position, const Colour& colour);
+    void eraseStop (int index) noexcept;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GradientModel);
+};
+
+
+#endif  // __GRADIENTMODEL_H_4B1E93A2__
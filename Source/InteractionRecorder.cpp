@@ -0,0 +1,512 @@
+/*
+  ==============================================================================
+
+    InteractionRecorder.cpp
+    Created: 19 Oct 2026 4:44:46am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "InteractionRecorder.h"
+#include "AllocationCounter.h"
+
+
+//==============================================================================
+InteractionRecorder::InteractionRecorder (GradientDesigner& designer_)
+    : designer (designer_),
+      recordingXml ("GRADIENTRECORDING"),
+      eventsXml (nullptr),
+      startTime (0.0),
+      recording (false)
+{
+}
+
+InteractionRecorder::~InteractionRecorder()
+{
+    stop();
+}
+
+//==============================================================================
+void InteractionRecorder::start()
+{
+    stop();
+
+    recordingXml.deleteAllChildElements();
+    recordingXml.setAttribute ("width", designer.getWidth());
+    recordingXml.setAttribute ("height", designer.getHeight());
+
+    addGradientToXml (*recordingXml.createNewChildElement ("INITIAL"), designer.getGradient());
+    eventsXml = recordingXml.createNewChildElement ("EVENTS");
+
+    startTime = Time::getMillisecondCounterHiRes();
+    recording = true;
+
+    designer.addMouseListener (this, true);
+    designer.getModel()->addListener (this);
+}
+
+void InteractionRecorder::stop()
+{
+    if (recording)
+    {
+        designer.removeMouseListener (this);
+        designer.getModel()->removeListener (this);
+
+        addGradientToXml (*recordingXml.createNewChildElement ("FINAL"), designer.getGradient());
+        recording = false;
+    }
+}
+
+int InteractionRecorder::getNumEvents() const
+{
+    return eventsXml != nullptr ? eventsXml->getNumChildElements() : 0;
+}
+
+XmlElement* InteractionRecorder::createXml() const
+{
+    return new XmlElement (recordingXml);
+}
+
+bool InteractionRecorder::saveToFile (const File& file)
+{
+    stop();
+
+    return recordingXml.writeToFile (file, String::empty);
+}
+
+//==============================================================================
+void InteractionRecorder::mouseDown (const MouseEvent& e)
+{
+    recordMouseEvent ("MOUSE", "down", e);
+}
+
+void InteractionRecorder::mouseDrag (const MouseEvent& e)
+{
+    recordMouseEvent ("MOUSE", "drag", e);
+}
+
+void InteractionRecorder::mouseUp (const MouseEvent& e)
+{
+    recordMouseEvent ("MOUSE", "up", e);
+}
+
+void InteractionRecorder::mouseDoubleClick (const MouseEvent& e)
+{
+    recordMouseEvent ("DOUBLECLICK", String::empty, e);
+}
+
+void InteractionRecorder::mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel)
+{
+    XmlElement* event = recordMouseEvent ("WHEEL", String::empty, e);
+    event->setAttribute ("deltaX", wheel.deltaX);
+    event->setAttribute ("deltaY", wheel.deltaY);
+    event->setAttribute ("reversed", wheel.isReversed);
+    event->setAttribute ("smooth", wheel.isSmooth);
+}
+
+void InteractionRecorder::gradientStopColourChanged (GradientModel* model, int index)
+{
+    XmlElement* event = eventsXml->createNewChildElement ("COLOUR");
+    event->setAttribute ("time", Time::getMillisecondCounterHiRes() - startTime);
+    event->setAttribute ("index", index);
+    event->setAttribute ("colour", model->getStopColour (index).toString());
+}
+
+XmlElement* InteractionRecorder::recordMouseEvent (const String& tagName, const String& type, const MouseEvent& e)
+{
+    // record positions relative to the designer as the markers move around
+    const Point<int> position (e.getEventRelativeTo (&designer).getPosition());
+
+    XmlElement* event = eventsXml->createNewChildElement (tagName);
+
+    if (type.isNotEmpty())
+        event->setAttribute ("type", type);
+
+    event->setAttribute ("time", Time::getMillisecondCounterHiRes() - startTime);
+    event->setAttribute ("x", position.getX());
+    event->setAttribute ("y", position.getY());
+    event->setAttribute ("mods", e.mods.getRawFlags());
+
+    return event;
+}
+
+//==============================================================================
+void InteractionRecorder::addGradientToXml (XmlElement& xml, const ColourGradient& gradient)
+{
+    for (int i = 0; i < gradient.getNumColours(); ++i)
+    {
+        XmlElement* stop = xml.createNewChildElement ("STOP");
+        stop->setAttribute ("position", gradient.getColourPosition (i));
+        stop->setAttribute ("colour", gradient.getColour (i).toString());
+    }
+}
+
+ColourGradient InteractionRecorder::createGradientFromXml (const XmlElement& xml)
+{
+    ColourGradient gradient;
+
+    forEachXmlChildElementWithTagName (xml, stop, "STOP")
+        gradient.addColour (stop->getDoubleAttribute ("position"),
+                            Colour::fromString (stop->getStringAttribute ("colour")));
+
+    return gradient;
+}
+
+//==============================================================================
+/** Counts the repaints a component and its children ask for.
+    Any repaint of a component with a cached image invalidates the image, which
+    happens even when the component isn't on screen.
+ */
+class InteractionReplayer::RepaintCounter   : public CachedComponentImage
+{
+public:
+    RepaintCounter (Component& owner_, int& numRepaintRequests_)
+        : owner (owner_), numRepaintRequests (numRepaintRequests_)
+    {
+    }
+
+    void paint (Graphics& g)                    { owner.paintEntireComponent (g, false); }
+    void invalidateAll()                        { ++numRepaintRequests; }
+    void invalidate (const Rectangle<int>&)     { ++numRepaintRequests; }
+    void releaseResources()                     {}
+
+private:
+    Component& owner;
+    int& numRepaintRequests;
+
+    JUCE_DECLARE_NON_COPYABLE (RepaintCounter);
+};
+
+//==============================================================================
+InteractionReplayer::Results::Results()
+    : numEvents (0), numRepaintRequests (0), numFramesPainted (0), numModelChanges (0), numChangeMessages (0),
+      numAllocations (0), numPaintAllocations (0), numRepaintAllocations (0),
+      totalEventMs (0.0), maxEventMs (0.0), totalPaintMs (0.0), totalMs (0.0),
+      gradientMatches (false)
+{
+}
+
+String InteractionReplayer::Results::toString() const
+{
+    String s;
+    s << "Events:           " << numEvents << newLine
+      << "Total time:       " << String (totalMs, 2) << " ms" << newLine
+      << "Event time:       " << String (totalEventMs, 2) << " ms (mean "
+                              << String (numEvents > 0 ? totalEventMs / numEvents : 0.0, 3) << " ms, max "
+                              << String (maxEventMs, 3) << " ms)" << newLine
+      << "Repaint requests: " << numRepaintRequests << newLine
+      << "Frames painted:   " << numFramesPainted << " (" << String (totalPaintMs, 2) << " ms)" << newLine
+      << "Model changes:    " << numModelChanges << newLine
+      << "Change messages:  " << numChangeMessages << newLine;
+
+    if (AllocationCounter::isEnabled())
+        s << "Allocations:      " << numAllocations << " handling events, "
+                                  << numPaintAllocations << " painting the frames" << newLine
+          << "                  (" << numRepaintAllocations << " painting them again unchanged)" << newLine;
+
+    s << "Final gradient:   " << (gradientMatches ? "matches" : "DOES NOT MATCH") << newLine
+      << newLine
+      << "Event  Type         Time (ms)" << newLine;
+
+    for (int i = 0; i < eventMs.size(); ++i)
+        s << String (i).paddedLeft (' ', 5) << "  "
+          << String (eventTypes[i]).paddedRight (' ', 11) << "  "
+          << String (eventMs.getUnchecked (i), 3) << newLine;
+
+    return s;
+}
+
+//==============================================================================
+InteractionReplayer::InteractionReplayer (GradientDesigner& designer_)
+    : designer (designer_), numModelChanges (0), numChangeMessages (0), numRepaintRequests (0)
+{
+}
+
+InteractionReplayer::~InteractionReplayer()
+{
+}
+
+InteractionReplayer::Results InteractionReplayer::replay (const File& recordingFile, bool useOriginalTiming)
+{
+    ScopedPointer<XmlElement> recording (XmlDocument::parse (recordingFile));
+
+    if (recording == nullptr)
+        return Results();
+
+    return replay (*recording, useOriginalTiming);
+}
+
+InteractionReplayer::Results InteractionReplayer::replay (const XmlElement& recording, bool useOriginalTiming)
+{
+    Results results;
+
+    const XmlElement* initialXml = recording.getChildByName ("INITIAL");
+    const XmlElement* eventsXml = recording.getChildByName ("EVENTS");
+    const XmlElement* finalXml = recording.getChildByName ("FINAL");
+
+    if (! recording.hasTagName ("GRADIENTRECORDING") || initialXml == nullptr || eventsXml == nullptr)
+    {
+        jassertfalse; // not a valid recording!
+        return results;
+    }
+
+    // the markers need to be visible for the events to find them
+    designer.setVisible (true);
+    designer.setSize (recording.getIntAttribute ("width"), recording.getIntAttribute ("height"));
+    designer.setGradient (InteractionRecorder::createGradientFromXml (*initialXml));
+
+    designer.addChangeListener (this);
+    designer.getModel()->addListener (this);
+    designer.dispatchPendingMessages();
+
+    numModelChanges = numChangeMessages = numRepaintRequests = 0;
+    mouseTarget = nullptr;
+    designer.setCachedComponentImage (new RepaintCounter (designer, numRepaintRequests));
+
+    parseEvents (*eventsXml);
+    results.eventMs.ensureStorageAllocated (events.size());
+    results.eventTypes.ensureStorageAllocated (events.size());
+
+    Image frame (Image::ARGB, jmax (1, designer.getWidth()), jmax (1, designer.getHeight()), true);
+    const double replayStartTime = Time::getMillisecondCounterHiRes();
+
+    for (int i = 0; i < events.size(); ++i)
+    {
+        const Event& event = events.getReference (i);
+
+        if (useOriginalTiming)
+            Time::waitForMillisecondCounter ((uint32) (replayStartTime + event.time));
+
+        const int numRepaintRequestsBefore = numRepaintRequests;
+        const int64 numAllocationsBefore = AllocationCounter::getNumAllocations();
+        const int64 eventStartTicks = Time::getHighResolutionTicks();
+
+        if (event.type == Event::colourEvent)
+        {
+            if (isPositiveAndBelow (event.index, designer.getModel()->getNumStops()))
+                designer.getModel()->setStopColour (event.index, event.colour);
+        }
+        else
+        {
+            sendMouseEvent (event, Time::getCurrentTime());
+        }
+
+        designer.dispatchPendingMessages();
+
+        const int64 eventEndTicks = Time::getHighResolutionTicks();
+        results.numAllocations += AllocationCounter::getNumAllocations() - numAllocationsBefore;
+
+        const double eventMs = Time::highResolutionTicksToSeconds (eventEndTicks - eventStartTicks) * 1000.0;
+        results.eventMs.add (eventMs);
+        results.eventTypes.add (getEventTypeName (event.type));
+        results.totalEventMs += eventMs;
+        results.maxEventMs = jmax (results.maxEventMs, eventMs);
+        ++results.numEvents;
+
+        // paint a frame like the screen would have done
+        if (numRepaintRequests != numRepaintRequestsBefore)
+        {
+            const int64 numPaintAllocationsBefore = AllocationCounter::getNumAllocations();
+            const int64 paintStartTicks = Time::getHighResolutionTicks();
+
+            {
+                Graphics g (frame);
+                designer.paintEntireComponent (g, true);
+            }
+
+            results.totalPaintMs += Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - paintStartTicks) * 1000.0;
+            ++results.numFramesPainted;
+
+            if (AllocationCounter::isEnabled())
+            {
+                const int64 numRepaintAllocationsBefore = AllocationCounter::getNumAllocations();
+                results.numPaintAllocations += numRepaintAllocationsBefore - numPaintAllocationsBefore;
+
+                // painting the unchanged frame again is only reported, it shows which
+                // of the allocations above painting makes whatever the edit was
+                {
+                    Graphics g (frame);
+                    designer.paintEntireComponent (g, true);
+                }
+
+                results.numRepaintAllocations += AllocationCounter::getNumAllocations() - numRepaintAllocationsBefore;
+            }
+        }
+
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        // deliver any messages the event posted like the real message loop would,
+        // otherwise the queue keeps growing and its allocations get counted
+        if (AllocationCounter::isEnabled())
+            MessageManager::getInstance()->runDispatchLoopUntil (1);
+       #endif
+    }
+
+    results.totalMs = Time::getMillisecondCounterHiRes() - replayStartTime;
+    results.numModelChanges = numModelChanges;
+    results.numChangeMessages = numChangeMessages;
+    results.numRepaintRequests = numRepaintRequests;
+    results.gradientMatches = finalXml != nullptr
+                                && gradientsMatch (InteractionRecorder::createGradientFromXml (*finalXml),
+                                                   designer.getGradient());
+
+    designer.setCachedComponentImage (nullptr);
+    designer.removeChangeListener (this);
+    designer.getModel()->removeListener (this);
+
+    return results;
+}
+
+//==============================================================================
+void InteractionReplayer::parseEvents (const XmlElement& eventsXml)
+{
+    events.clearQuick();
+
+    forEachXmlChildElement (eventsXml, eventXml)
+    {
+        Event event;
+        event.time = eventXml->getDoubleAttribute ("time");
+        event.position = Point<int> (eventXml->getIntAttribute ("x"), eventXml->getIntAttribute ("y"));
+        event.mods = eventXml->getIntAttribute ("mods");
+        event.index = eventXml->getIntAttribute ("index", -1);
+        event.wheel.deltaX = (float) eventXml->getDoubleAttribute ("deltaX");
+        event.wheel.deltaY = (float) eventXml->getDoubleAttribute ("deltaY");
+        event.wheel.isReversed = eventXml->getBoolAttribute ("reversed");
+        event.wheel.isSmooth = eventXml->getBoolAttribute ("smooth");
+
+        if (eventXml->hasTagName ("MOUSE"))
+        {
+            const String type (eventXml->getStringAttribute ("type"));
+
+            if (type == "down")         event.type = Event::mouseDownEvent;
+            else if (type == "drag")    event.type = Event::mouseDragEvent;
+            else if (type == "up")      event.type = Event::mouseUpEvent;
+            else                        continue;
+        }
+        else if (eventXml->hasTagName ("DOUBLECLICK"))
+        {
+            event.type = Event::mouseDoubleClickEvent;
+        }
+        else if (eventXml->hasTagName ("WHEEL"))
+        {
+            event.type = Event::mouseWheelEvent;
+        }
+        else if (eventXml->hasTagName ("COLOUR"))
+        {
+            event.type = Event::colourEvent;
+            event.colour = Colour::fromString (eventXml->getStringAttribute ("colour"));
+        }
+        else
+        {
+            continue;
+        }
+
+        events.add (event);
+    }
+}
+
+void InteractionReplayer::sendMouseEvent (const Event& event, const Time& time)
+{
+    const Event::Type type = event.type;
+    const Point<int>& position = event.position;
+    const ModifierKeys mods (event.mods);
+
+    if (type == Event::mouseDoubleClickEvent || type == Event::mouseWheelEvent)
+    {
+        // these go to whatever is under the mouse and aren't part of a drag. A marker
+        // doesn't use the wheel so, like the real event, it gets passed up to the designer
+        Component* const target = designer.getComponentAt (position);
+
+        if (target == nullptr)
+            return;
+
+        const Point<int> localPosition (target->getLocalPoint (&designer, position));
+        const MouseEvent e (Desktop::getInstance().getMainMouseSource(),
+                            localPosition, mods, target, target, time,
+                            localPosition, time, type == Event::mouseDoubleClickEvent ? 2 : 1, false);
+
+        if (type == Event::mouseDoubleClickEvent)
+            target->mouseDoubleClick (e);
+        else
+            target->mouseWheelMove (e, event.wheel);
+
+        return;
+    }
+
+    if (type == Event::mouseDownEvent)
+    {
+        mouseTarget = designer.getComponentAt (position);
+        mouseDownPosition = position;
+        mouseDownTime = time;
+    }
+
+    Component* const target = mouseTarget;
+
+    if (target == nullptr)
+        return;
+
+    // right-clicking a marker opens a colour selector, the colours it picked are
+    // recorded as separate events so just skip these
+    if (mods.isPopupMenu() && target != &designer)
+        return;
+
+    const MouseEvent e (Desktop::getInstance().getMainMouseSource(),
+                        target->getLocalPoint (&designer, position),
+                        mods, target, target, time,
+                        target->getLocalPoint (&designer, mouseDownPosition),
+                        mouseDownTime, 1, type == Event::mouseDragEvent);
+
+    if (type == Event::mouseDownEvent)
+    {
+        target->mouseDown (e);
+    }
+    else if (type == Event::mouseDragEvent)
+    {
+        target->mouseDrag (e);
+    }
+    else if (type == Event::mouseUpEvent)
+    {
+        target->mouseUp (e);
+        mouseTarget = nullptr;
+    }
+}
+
+const char* InteractionReplayer::getEventTypeName (Event::Type type) noexcept
+{
+    switch (type)
+    {
+        case Event::mouseDownEvent:         return "down";
+        case Event::mouseDragEvent:         return "drag";
+        case Event::mouseUpEvent:           return "up";
+        case Event::mouseDoubleClickEvent:  return "doubleclick";
+        case Event::mouseWheelEvent:        return "wheel";
+        case Event::colourEvent:            return "colour";
+        default:                            break;
+    }
+
+    return "unknown";
+}
+
+bool InteractionReplayer::gradientsMatch (const ColourGradient& a, const ColourGradient& b)
+{
+    if (a.getNumColours() != b.getNumColours())
+        return false;
+
+    for (int i = 0; i < a.getNumColours(); ++i)
+        if (std::abs (a.getColourPosition (i) - b.getColourPosition (i)) > 1.0e-6
+             || a.getColour (i) != b.getColour (i))
+            return false;
+
+    return true;
+}
+
+void InteractionReplayer::changeListenerCallback (ChangeBroadcaster*)
+{
+    ++numChangeMessages;
+}
+
+void InteractionReplayer::gradientChanged (GradientModel*)
+{
+    ++numModelChanges;
+}
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    InteractionRecorder.h
+    Created: 19 Oct 2026 4:44:46am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __INTERACTIONRECORDER_H_71A8E05C__
+#define __INTERACTIONRECORDER_H_71A8E05C__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientDesigner.h"
+
+
+//==============================================================================
+/**
+    Records the mouse, mouse-wheel and colour picker events sent to a GradientDesigner
+    so they can be replayed later with an InteractionReplayer.
+
+    Wheel and double-click events are recorded as well as clicks and drags because
+    they zoom the designer, which changes which stop positions the later mouse
+    positions refer to.
+
+    The recording holds the designer's size, the gradient it started with, the
+    timestamped events and the gradient it finished with so a replay can check
+    it ends up in the same state.
+
+    @see InteractionReplayer
+ */
+class InteractionRecorder   : public MouseListener,
+                              public GradientModel::Listener
+{
+public:
+    //==============================================================================
+    /** Creates a recorder for a designer. Nothing is recorded until start() is called. */
+    InteractionRecorder (GradientDesigner& designer);
+
+    /** Destructor. */
+    ~InteractionRecorder();
+
+    //==============================================================================
+    /** Clears any previous recording and starts recording from the current state. */
+    void start();
+
+    /** Stops recording and captures the final gradient. */
+    void stop();
+
+    /** Returns true if events are currently being recorded. */
+    bool isRecording() const noexcept           { return recording; }
+
+    /** Returns the number of events recorded so far. */
+    int getNumEvents() const;
+
+    /** Returns a copy of the recording. The caller is responsible for deleting it. */
+    XmlElement* createXml() const;
+
+    /** Saves the recording to a file, stopping it first if necessary. */
+    bool saveToFile (const File& file);
+
+    //==============================================================================
+    /** @internal */
+    void mouseDown (const MouseEvent& e);
+
+    /** @internal */
+    void mouseDrag (const MouseEvent& e);
+
+    /** @internal */
+    void mouseUp (const MouseEvent& e);
+
+    /** @internal */
+    void mouseDoubleClick (const MouseEvent& e);
+
+    /** @internal */
+    void mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel);
+
+    /** @internal */
+    void gradientStopColourChanged (GradientModel* model, int index);
+
+    //==============================================================================
+    /** Adds the stops of a gradient to an XmlElement as child elements. */
+    static void addGradientToXml (XmlElement& xml, const ColourGradient& gradient);
+
+    /** Reads a gradient saved with addGradientToXml(). */
+    static ColourGradient createGradientFromXml (const XmlElement& xml);
+
+private:
+    //==============================================================================
+    GradientDesigner& designer;
+    XmlElement recordingXml;
+    XmlElement* eventsXml;
+    double startTime;
+    bool recording;
+
+    XmlElement* recordMouseEvent (const String& tagName, const String& type, const MouseEvent& e);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InteractionRecorder);
+};
+
+//==============================================================================
+/**
+    Replays a recording made with an InteractionRecorder against a designer.
+
+    The events are delivered directly to the designer and its markers so this
+    works without the designer being on screen. Every repaint the designer or its
+    markers ask for is counted, and after each event that asked for one a frame is
+    painted into an offscreen image to include the painting cost, like the screen
+    would. Any pending change messages are dispatched and counted too.
+
+    When the build counts allocations (see AllocationCounter) the number of heap
+    allocations made while handling the events and painting the frames is also
+    collected. Each frame is then painted a second time without anything having
+    changed; those allocations are only reported, to tell what painting costs on
+    its own apart from what the edit caused. Replaying the same recording twice and
+    checking the second pass makes no allocations handling events or painting the
+    frames shows that editing is allocation free once warmed up.
+
+    @see InteractionRecorder
+ */
+class InteractionReplayer   : private ChangeListener,
+                              private GradientModel::Listener
+{
+public:
+    //==============================================================================
+    /** The timing and counts collected during a replay. */
+    struct Results
+    {
+        Results();
+
+        int numEvents, numRepaintRequests, numFramesPainted, numModelChanges, numChangeMessages;
+        int64 numAllocations, numPaintAllocations, numRepaintAllocations;
+        double totalEventMs, maxEventMs, totalPaintMs, totalMs;
+        Array<double> eventMs;
+        Array<const char*> eventTypes;
+        bool gradientMatches;
+
+        /** Returns a multi-line, human readable summary followed by a line for
+            each event with its index, type and the time it took to handle.
+         */
+        String toString() const;
+    };
+
+    //==============================================================================
+    /** Creates a replayer for a designer. */
+    InteractionReplayer (GradientDesigner& designer);
+
+    /** Destructor. */
+    ~InteractionReplayer();
+
+    /** Replays a recording, blocking until it has finished.
+
+        The designer is resized and reset to the recording's starting gradient first.
+        This must be called on the message thread.
+
+        @param recording        A recording created by InteractionRecorder
+        @param useOriginalTiming If true, events are spaced out as they were when
+                                 recorded, otherwise they are sent as fast as possible
+     */
+    Results replay (const XmlElement& recording, bool useOriginalTiming);
+
+    /** Loads a recording from a file and replays it. */
+    Results replay (const File& recordingFile, bool useOriginalTiming);
+
+private:
+    //==============================================================================
+    class RepaintCounter;
+
+    /** An event read from the recording before the replay starts, so that nothing
+        needs to be looked up or converted while the events are being timed.
+     */
+    struct Event
+    {
+        enum Type
+        {
+            mouseDownEvent,
+            mouseDragEvent,
+            mouseUpEvent,
+            mouseDoubleClickEvent,
+            mouseWheelEvent,
+            colourEvent
+        };
+
+        Type type;
+        double time;
+        Point<int> position;
+        int mods, index;
+        Colour colour;
+        MouseWheelDetails wheel;
+    };
+
+    GradientDesigner& designer;
+    Array<Event> events;
+    Component::SafePointer<Component> mouseTarget;
+    Point<int> mouseDownPosition;
+    Time mouseDownTime;
+    int numModelChanges, numChangeMessages, numRepaintRequests;
+
+    void parseEvents (const XmlElement& eventsXml);
+    void sendMouseEvent (const Event& event, const Time& time);
+
+    static const char* getEventTypeName (Event::Type type) noexcept;
+    static bool gradientsMatch (const ColourGradient& a, const ColourGradient& b);
+
+    void changeListenerCallback (ChangeBroadcaster* source);
+    void gradientChanged (GradientModel* model);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InteractionReplayer);
+};
+
+
+#endif  // __INTERACTIONRECORDER_H_71A8E05C__
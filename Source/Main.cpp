@@ -10,6 +10,9 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "MainWindow.h"
+#include "MainComponent.h"
+#include "InteractionRecorder.h"
+#include "AllocationCounter.h"
 
 
 //==============================================================================
@@ -29,7 +32,47 @@ public:
     void initialise (const String& commandLine)
     {
         // Add your application's initialisation code here..
+        StringArray args;
+        args.addTokens (commandLine, true);
+
+        // --replay <file> [--realtime] [--check-allocations] [--results <file>] plays
+        // back a recording without showing any windows. Tools/check_allocations.sh
+        // and .bat build a counting copy of the app and run the allocation check
+        const int replayIndex = args.indexOf ("--replay");
+
+        if (replayIndex >= 0)
+        {
+            const int resultsIndex = args.indexOf ("--results");
+
+            runReplay (getFileArgument (args, replayIndex), args.contains ("--realtime"),
+                       args.contains ("--check-allocations"),
+                       resultsIndex >= 0 ? getFileArgument (args, resultsIndex) : File::nonexistent);
+            return;
+        }
+
         mainWindow = new MainAppWindow();
+
+        // --record <file> saves all the designer events to the file when quitting
+        const int recordIndex = args.indexOf ("--record");
+
+        if (recordIndex >= 0)
+            if (MainComponent* mainComponent = dynamic_cast<MainComponent*> (mainWindow->getContentComponent()))
+                mainComponent->startRecording (getFileArgument (args, recordIndex));
+
+        // --field <file> previews the gradient on a raw scalar field
+        const int fieldIndex = args.indexOf ("--field");
+
+        if (fieldIndex >= 0)
+            if (MainComponent* mainComponent = dynamic_cast<MainComponent*> (mainWindow->getContentComponent()))
+                mainComponent->openScalarField (getFileArgument (args, fieldIndex));
+
+        // --publish <name> publishes the gradient to a POSIX shared memory segment,
+        // e.g. --publish /my-gradient, so other processes can follow the edits
+        const int publishIndex = args.indexOf ("--publish");
+
+        if (publishIndex >= 0)
+            if (MainComponent* mainComponent = dynamic_cast<MainComponent*> (mainWindow->getContentComponent()))
+                mainComponent->publishToSharedMemory (args[publishIndex + 1].unquoted());
     }
 
     void shutdown()
@@ -66,6 +109,66 @@ public:
 
 private:
     ScopedPointer <MainAppWindow> mainWindow;
+
+    //==============================================================================
+    static File getFileArgument (const StringArray& args, int flagIndex)
+    {
+        return File::getCurrentWorkingDirectory().getChildFile (args[flagIndex + 1].unquoted());
+    }
+
+    void runReplay (const File& recordingFile, bool useOriginalTiming, bool checkAllocations,
+                    const File& resultsFile)
+    {
+        GradientDesigner designer (ColourGradient (Colours::blue, 0, 0,
+                                                   Colours::red, 0, 0,
+                                                   false));
+
+        InteractionReplayer replayer (designer);
+        String report;
+        bool passed = true;
+
+        if (checkAllocations)
+        {
+            if (! AllocationCounter::isEnabled())
+            {
+                report << "This build doesn't count allocations, "
+                          "rebuild with GRADIENTDESIGNER_COUNT_ALLOCATIONS=1" << newLine;
+                passed = false;
+            }
+            else
+            {
+                // the first pass creates all the markers, storage etc. that the
+                // recording needs, after that editing shouldn't allocate at all
+                replayer.replay (recordingFile, false);
+            }
+        }
+
+        const InteractionReplayer::Results results (replayer.replay (recordingFile, useOriginalTiming));
+
+        report << results.toString();
+
+        // recorded colour changes are applied straight to the model, the picker
+        // needs the desktop so it never gets opened without a window
+        if (checkAllocations)
+            report << "Not covered:      the colour picker (its call-out box and ColourSelector)" << newLine;
+
+        if (checkAllocations && results.numAllocations + results.numPaintAllocations > 0)
+        {
+            report << "Editing allocated " << results.numAllocations << " times handling events and "
+                   << results.numPaintAllocations << " times painting after warming up" << newLine;
+            passed = false;
+        }
+
+        // GUI builds have no console on Windows, so the logger sends this to the
+        // debugger there and a file can be given to keep it
+        Logger::writeToLog (report);
+
+        if (resultsFile != File::nonexistent)
+            resultsFile.replaceWithText (report);
+
+        setApplicationReturnValue (passed && results.gradientMatches ? 0 : 1);
+        quit();
+    }
 };
 
 //==============================================================================
@@ -15,40 +15,139 @@
 MainComponent::MainComponent()
     : gradientDesigner (ColourGradient (Colours::blue, 0, 0,
                                         Colours::red, 0, 0,
-                                        false))
+                                        false)),
+      openFieldButton ("Open Field..."),
+      fieldView (gradientDesigner.getModel())
 {
     addAndMakeVisible (&gradientDesigner);
-    gradientDesigner.addChangeListener (this);
+
+    previewModeBox.addItem ("Radial Gradient", radialPreview);
+    previewModeBox.addItem ("Scalar Field", scalarFieldPreview);
+    previewModeBox.addListener (this);
+    addAndMakeVisible (&previewModeBox);
+
+    openFieldButton.addListener (this);
+    addChildComponent (&openFieldButton);
+    addChildComponent (&fieldView);
+
+    setPreviewMode (radialPreview);
+
+    // avoid banding in the previews
+    gradientDesigner.setDitheredPreview (true, false);
+    previewCache.setDithering (true, false);
+
+    gradientDesigner.getModel()->addListener (this);
 }
 
 MainComponent::~MainComponent()
 {
-    gradientDesigner.removeChangeListener (this);
+    if (recorder != nullptr)
+        recorder->saveToFile (recordingFile);
+
+    gradientDesigner.getModel()->removeListener (this);
 }
 
 void MainComponent::paint (Graphics& g)
 {
-    Rectangle<int> radialBoundsInt (getLocalBounds().removeFromBottom (getLocalBounds().getCentreY()));
-    Rectangle<float> radialBounds (radialBoundsInt.toFloat());
-    
-    ColourGradient cg (gradientDesigner.getGradient());
-    cg.isRadial = true;
-    cg.point1 = radialBounds.getTopLeft();
-    cg.point2 = radialBounds.getBottomRight();
-    
-    g.setGradientFill (cg);
-    g.fillRect (radialBoundsInt);
+    if (previewModeBox.getSelectedId() == radialPreview)
+        previewCache.draw (g, *gradientDesigner.getModel(), getPreviewArea(), true,
+                           GradientImageCache::getScaleFactorFor (*this));
 }
 
 void MainComponent::resized()
 {
     gradientDesigner.setBounds (getLocalBounds().withHeight (getLocalBounds().getCentreY()));
+
+    Rectangle<int> controlsArea (getLocalBounds().removeFromBottom (getLocalBounds().getCentreY()));
+    controlsArea = controlsArea.removeFromTop (26).reduced (2);
+    previewModeBox.setBounds (controlsArea.removeFromLeft (150));
+    openFieldButton.setBounds (controlsArea.removeFromLeft (100).translated (4, 0));
+
+    fieldView.setBounds (getPreviewArea());
 }
 
-void MainComponent::changeListenerCallback (ChangeBroadcaster* source)
+void MainComponent::gradientChanged (GradientModel* model)
 {
-    if (source == &gradientDesigner)
+    // the field view listens to the model itself
+    if (model == gradientDesigner.getModel() && previewModeBox.getSelectedId() == radialPreview)
     {
         repaint();
     }
 }
+
+void MainComponent::buttonClicked (Button* button)
+{
+    if (button == &openFieldButton)
+    {
+        FileChooser chooser ("Open a raw scalar field named like name_<width>x<height>_<float32|uint16>.raw",
+                             File::nonexistent, "*.raw;*.bin;*.dat");
+
+        if (chooser.browseForFileToOpen())
+            openScalarField (chooser.getResult());
+    }
+}
+
+void MainComponent::comboBoxChanged (ComboBox* comboBox)
+{
+    if (comboBox == &previewModeBox)
+        setPreviewMode ((PreviewMode) previewModeBox.getSelectedId());
+}
+
+void MainComponent::startRecording (const File& fileToSaveTo)
+{
+    recordingFile = fileToSaveTo;
+    recorder = new InteractionRecorder (gradientDesigner);
+    recorder->start();
+}
+
+bool MainComponent::openScalarField (const File& file)
+{
+    ScalarField::Format format;
+
+    if (! format.parseFromFileName (file.getFileName()))
+    {
+        AlertWindow::showMessageBox (AlertWindow::WarningIcon, "Unknown Field Format",
+                                     "The size and type of the field couldn't be worked out from its name, "
+                                     "it should look like name_<width>x<height>_<float32|uint16>.raw");
+        return false;
+    }
+
+    if (! fieldView.openField (file, format))
+    {
+        AlertWindow::showMessageBox (AlertWindow::WarningIcon, "Couldn't Open Field",
+                                     "The file couldn't be mapped or is smaller than its name says it should be.");
+        return false;
+    }
+
+    setPreviewMode (scalarFieldPreview);
+    return true;
+}
+
+bool MainComponent::publishToSharedMemory (const String& segmentName)
+{
+    if (gradientDesigner.publishToSharedMemory (segmentName))
+        return true;
+
+    AlertWindow::showMessageBox (AlertWindow::WarningIcon, "Couldn't Publish Gradient",
+                                 "The shared memory segment \"" + segmentName + "\" couldn't be created. "
+                                 "The name may already be in use, or shared memory isn't available on this platform.");
+    return false;
+}
+
+//==============================================================================
+Rectangle<int> MainComponent::getPreviewArea() const
+{
+    Rectangle<int> previewArea (getLocalBounds().removeFromBottom (getLocalBounds().getCentreY()));
+    previewArea.removeFromTop (26);
+
+    return previewArea;
+}
+
+void MainComponent::setPreviewMode (PreviewMode newMode)
+{
+    previewModeBox.setSelectedId (newMode, true);
+    openFieldButton.setVisible (newMode == scalarFieldPreview);
+    fieldView.setVisible (newMode == scalarFieldPreview);
+
+    repaint();
+}
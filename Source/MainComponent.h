@@ -13,13 +13,17 @@
 
 #include "../JuceLibraryCode/JuceHeader.h"
 #include  "GradientDesigner.h"
+#include  "InteractionRecorder.h"
+#include  "ScalarFieldView.h"
 
 
 //==============================================================================
 /*
 */
 class MainComponent :   public Component,
-                        public ChangeListener
+                        public GradientModel::Listener,
+                        public ButtonListener,
+                        public ComboBoxListener
 {
 public:
     MainComponent();
@@ -30,11 +34,49 @@ public:
     
     void resized();
 
-    void changeListenerCallback (ChangeBroadcaster* source);
+    void gradientChanged (GradientModel* model);
+
+    void buttonClicked (Button* button);
+
+    void comboBoxChanged (ComboBox* comboBox);
+
+    /** Starts recording the designer's events, saving them to a file when the
+        component is deleted.
+     */
+    void startRecording (const File& fileToSaveTo);
+
+    /** Opens a raw scalar field and switches the preview to show the gradient
+        applied to it. The field's size and type are read from its file name.
+        @see ScalarField::Format::parseFromFileName
+     */
+    bool openScalarField (const File& file);
+
+    /** Publishes the gradient to a named shared memory segment so other processes
+        can follow the edits, showing an alert if the segment can't be created.
+        @see GradientDesigner::publishToSharedMemory
+     */
+    bool publishToSharedMemory (const String& segmentName);
     
 private:
     //==============================================================================
     GradientDesigner gradientDesigner;
+    GradientImageCache previewCache;
+
+    enum PreviewMode
+    {
+        radialPreview = 1,
+        scalarFieldPreview
+    };
+
+    ComboBox previewModeBox;
+    TextButton openFieldButton;
+    ScalarFieldView fieldView;
+
+    ScopedPointer<InteractionRecorder> recorder;
+    File recordingFile;
+
+    Rectangle<int> getPreviewArea() const;
+    void setPreviewMode (PreviewMode newMode);
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent);
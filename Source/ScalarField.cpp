@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+    ScalarField.cpp
+    Created: 19 Oct 2026 4:58:49am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ScalarField.h"
+#include <limits>
+
+
+//==============================================================================
+namespace ScalarFieldHelpers
+{
+    /** The most values averaged along each side of a downsampled block. */
+    const int maxSamplesPerAxis = 4;
+
+    /** From this step up, each block is read from the single value at its centre.
+        The columns averaged along a row are far closer together than a page, so
+        every row read pages in the whole row; at these levels averaging several
+        rows per block would page in that many times more of the file.
+     */
+    const int minPointSampledStep = 16;
+
+    /** The number of values along each side of the grid used to find the value range. */
+    const int numRangeSamples = 256;
+
+    inline float getMissingValue() noexcept
+    {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    template <typename SampleType>
+    void readDownsampledRow (const SampleType* data, int64 width, int64 height,
+                             int64 sourceX, int64 sourceY, int step,
+                             float* dest, int numValues)
+    {
+        const int64 endY = jmin (height, sourceY + step);
+
+        if (step >= minPointSampledStep)
+        {
+            const SampleType* const row = sourceY < endY ? data + jmin (endY - 1, sourceY + step / 2) * width
+                                                         : nullptr;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const int64 startX = sourceX + (int64) i * step;
+                const int64 endX = jmin (width, startX + step);
+
+                dest[i] = (row != nullptr && startX < endX) ? (float) row[jmin (endX - 1, startX + step / 2)]
+                                                            : getMissingValue();
+            }
+
+            return;
+        }
+
+        const int stride = jmax (1, step / maxSamplesPerAxis);
+
+        for (int i = 0; i < numValues; ++i)
+            dest[i] = 0.0f;
+
+        // go through the rows in order so the file is read as sequentially as possible
+        for (int64 y = sourceY; y < endY; y += stride)
+        {
+            const SampleType* const row = data + y * width;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const int64 startX = sourceX + (int64) i * step;
+                const int64 endX = jmin (width, startX + step);
+                float sum = 0.0f;
+
+                for (int64 x = startX; x < endX; x += stride)
+                    sum += (float) row[x];
+
+                dest[i] += sum;
+            }
+        }
+
+        const int64 numRows = (endY - sourceY + stride - 1) / stride;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            const int64 startX = sourceX + (int64) i * step;
+            const int64 numColumns = (jmin (width, startX + step) - startX + stride - 1) / stride;
+
+            // a NaN in the block will have made the sum NaN too
+            dest[i] = (numRows > 0 && numColumns > 0) ? dest[i] / (float) (numRows * numColumns)
+                                                      : getMissingValue();
+        }
+    }
+}
+
+//==============================================================================
+ScalarField::Format::Format()
+    : width (0), height (0), type (float32), headerSize (0)
+{
+}
+
+bool ScalarField::Format::parseFromFileName (const String& fileName)
+{
+    StringArray tokens;
+    tokens.addTokens (fileName.upToLastOccurrenceOf (".", false, false), "_", String::empty);
+
+    if (tokens.size() < 2)
+        return false;
+
+    const String typeName (tokens[tokens.size() - 1].toLowerCase());
+    const String size (tokens[tokens.size() - 2].toLowerCase());
+
+    if (typeName == "float32" || typeName == "f32")
+        type = float32;
+    else if (typeName == "uint16" || typeName == "u16")
+        type = uint16;
+    else
+        return false;
+
+    if (! size.containsChar ('x'))
+        return false;
+
+    width = size.upToFirstOccurrenceOf ("x", false, false).getIntValue();
+    height = size.fromFirstOccurrenceOf ("x", false, false).getIntValue();
+    headerSize = 0;
+
+    return width > 0 && height > 0;
+}
+
+int ScalarField::Format::getBytesPerValue() const noexcept
+{
+    return type == float32 ? 4 : 2;
+}
+
+//==============================================================================
+ScalarField::ScalarField()
+    : data (nullptr)
+{
+}
+
+ScalarField::~ScalarField()
+{
+}
+
+bool ScalarField::open (const File& newFile, const Format& newFormat)
+{
+    close();
+
+    if (newFormat.width <= 0 || newFormat.height <= 0 || newFormat.headerSize < 0)
+        return false;
+
+    ScopedPointer<MemoryMappedFile> newMappedFile (new MemoryMappedFile (newFile, MemoryMappedFile::readOnly));
+
+    const int64 requiredSize = newFormat.headerSize
+                                + (int64) newFormat.width * newFormat.height * newFormat.getBytesPerValue();
+
+    if (newMappedFile->getData() == nullptr || (int64) newMappedFile->getSize() < requiredSize)
+        return false;
+
+    file = newFile;
+    format = newFormat;
+    mappedFile = newMappedFile;
+    data = addBytesToPointer (mappedFile->getData(), (size_t) format.headerSize);
+
+    return true;
+}
+
+void ScalarField::close()
+{
+    data = nullptr;
+    mappedFile = nullptr;
+    file = File::nonexistent;
+    format = Format();
+}
+
+//==============================================================================
+void ScalarField::readDownsampledRow (int64 sourceX, int64 sourceY, int step,
+                                      float* dest, int numValues) const
+{
+    jassert (isOpen() && step > 0 && sourceX >= 0 && sourceY >= 0);
+
+    if (sourceY >= format.height)
+    {
+        for (int i = 0; i < numValues; ++i)
+            dest[i] = ScalarFieldHelpers::getMissingValue();
+
+        return;
+    }
+
+    if (format.type == float32)
+        ScalarFieldHelpers::readDownsampledRow (static_cast<const float*> (data), format.width, format.height,
+                                                sourceX, sourceY, step, dest, numValues);
+    else
+        ScalarFieldHelpers::readDownsampledRow (static_cast<const uint16*> (data), format.width, format.height,
+                                                sourceX, sourceY, step, dest, numValues);
+}
+
+Range<float> ScalarField::findValueRange (ThreadPoolJob* jobToCheck) const
+{
+    using namespace ScalarFieldHelpers;
+
+    jassert (isOpen());
+
+    const int numX = jmin (numRangeSamples, format.width);
+    const int numY = jmin (numRangeSamples, format.height);
+    Range<float> valueRange;
+    bool foundAny = false;
+    float value;
+
+    for (int y = 0; y < numY; ++y)
+    {
+        if (jobToCheck != nullptr && jobToCheck->shouldExit())
+            return Range<float>();
+
+        const int64 sourceY = (int64) y * format.height / numY;
+
+        for (int x = 0; x < numX; ++x)
+        {
+            const int64 sourceX = (int64) x * format.width / numX;
+            readDownsampledRow (sourceX, sourceY, 1, &value, 1);
+
+            // skip NaNs and infinities, which would leave no range to stretch the gradient over
+            if (std::abs (value) <= std::numeric_limits<float>::max())
+            {
+                valueRange = foundAny ? valueRange.getUnionWith (value) : Range<float> (value, value);
+                foundAny = true;
+            }
+        }
+    }
+
+    if (! foundAny)
+        return Range<float> (0.0f, 1.0f);
+
+    if (valueRange.isEmpty())
+        return valueRange.withLength (1.0f);
+
+    return valueRange;
+}
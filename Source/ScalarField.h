@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    ScalarField.h
+    Created: 19 Oct 2026 4:58:49am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __SCALARFIELD_H_E61B04D9__
+#define __SCALARFIELD_H_E61B04D9__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+
+//==============================================================================
+/**
+    A large 2D grid of raw scalar values that is memory-mapped rather than loaded.
+
+    The file should contain the values row by row in the machine's native byte
+    order, optionally after a fixed size header. Nothing is read until values are
+    asked for, at which point the OS pages in just the parts of the file needed,
+    so fields much larger than the available memory can be used.
+
+    Reading is thread safe once the field has been opened, so several threads can
+    read different areas at once. The field must not be closed while this happens.
+
+    @see ScalarFieldView
+ */
+class ScalarField
+{
+public:
+    //==============================================================================
+    /** The formats that values can be stored in. */
+    enum DataType
+    {
+        float32,    /**< 32-bit floating point. NaNs are treated as missing values. */
+        uint16      /**< 16-bit unsigned integers. */
+    };
+
+    /** Describes the layout of a raw field file. */
+    struct Format
+    {
+        Format();
+
+        int width, height;
+        DataType type;
+        int64 headerSize;
+
+        /** Tries to read the layout from a file name of the form
+            "name_<width>x<height>_<float32|uint16>.raw", e.g. "depth_40000x30000_uint16.raw".
+         */
+        bool parseFromFileName (const String& fileName);
+
+        /** Returns the number of bytes used by each value. */
+        int getBytesPerValue() const noexcept;
+    };
+
+    //==============================================================================
+    /** Creates an empty field. */
+    ScalarField();
+
+    /** Destructor. */
+    ~ScalarField();
+
+    //==============================================================================
+    /** Maps a file, replacing any previously opened one.
+        Nothing is read from the file here, see findValueRange().
+
+        @returns true if the file could be mapped and is big enough for the format
+     */
+    bool open (const File& file, const Format& format);
+
+    /** Unmaps the file. */
+    void close();
+
+    /** Returns true if a file is open. */
+    bool isOpen() const noexcept                        { return data != nullptr; }
+
+    /** Returns the file currently open. */
+    const File& getFile() const noexcept                { return file; }
+
+    /** Returns the number of values in each row. */
+    int getWidth() const noexcept                       { return format.width; }
+
+    /** Returns the number of rows. */
+    int getHeight() const noexcept                      { return format.height; }
+
+    /** Finds the approximate range of values in the field by sampling a sparse grid.
+
+        The samples are scattered all over the file, so on a large file that isn't
+        already cached this can take a while and is best called on a background
+        thread.
+
+        @param jobToCheck   If this isn't null, sampling stops as soon as the job is
+                            asked to exit and an empty range is returned
+        @returns the range, or an empty range if sampling was stopped
+     */
+    Range<float> findValueRange (ThreadPoolJob* jobToCheck = nullptr) const;
+
+    //==============================================================================
+    /** Reads a downsampled row of values.
+
+        Each value written is the average of a step by step block of the field,
+        starting at sourceX, sourceY and moving step values along for each one. At
+        most a few values along each side of a block are averaged, and at coarse
+        steps only the value at the centre of each block is read, so one row of the
+        file is paged in per row of blocks. Even so, a full pass at a coarse step
+        still touches about 1 / step of the file. Blocks lying outside the field, or
+        containing missing values, are set to NaN.
+
+        @param sourceX      The column of the first block's top-left corner
+        @param sourceY      The row of the blocks' top edges
+        @param step         The width and height of each block
+        @param dest         The buffer to write to
+        @param numValues    The number of blocks to read
+     */
+    void readDownsampledRow (int64 sourceX, int64 sourceY, int step,
+                             float* dest, int numValues) const;
+
+private:
+    //==============================================================================
+    File file;
+    Format format;
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    const void* data;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScalarField);
+};
+
+
+#endif  // __SCALARFIELD_H_E61B04D9__
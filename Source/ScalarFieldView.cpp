@@ -0,0 +1,573 @@
+/*
+  ==============================================================================
+
+    ScalarFieldView.cpp
+    Created: 19 Oct 2026 4:58:49am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "ScalarFieldView.h"
+#include "GradientImageCache.h"
+
+
+//==============================================================================
+namespace ScalarFieldViewHelpers
+{
+    /** The number of values along each side of a tile. */
+    const int tileSize = 256;
+
+    /** The number of entries in the colour look-up table. */
+    const int lookupTableSize = 1024;
+
+    /** The number of tiles kept in memory, about 256k each plus the image. */
+    const int maxNumTiles = 160;
+
+    /** The highest downsampling level, i.e. 1 value for every 2^maxLevel. */
+    const int maxLevel = 24;
+
+    /** How many levels coarser to look for a tile to show while one is loading. */
+    const int maxFallbackLevels = 6;
+
+    /** The most a field can be magnified. */
+    const double minViewScale = 1.0 / 32.0;
+}
+
+//==============================================================================
+/** A square of downsampled values that is read on one of the view's threads. */
+class ScalarFieldView::Tile :   public ThreadPoolJob
+{
+public:
+    //==============================================================================
+    Tile (ScalarFieldView& owner_, int level_, int tileX_, int tileY_)
+        : ThreadPoolJob ("Scalar field tile"),
+          level (level_), tileX (tileX_), tileY (tileY_), lastUsed (0),
+          owner (owner_),
+          values ((size_t) (ScalarFieldViewHelpers::tileSize * ScalarFieldViewHelpers::tileSize)),
+          colourVersion (0), hasColours (false)
+    {
+    }
+
+    JobStatus runJob()
+    {
+        using namespace ScalarFieldViewHelpers;
+
+        const int step = 1 << level;
+        const int64 sourceX = (int64) tileX * tileSize * step;
+        const int64 sourceY = (int64) tileY * tileSize * step;
+
+        for (int y = 0; y < tileSize; ++y)
+        {
+            // the tile has scrolled out of view. It may have come back into view
+            // while it was stopping though, so get the view to check again
+            if (shouldExit())
+            {
+                interrupted.set (1);
+                owner.triggerAsyncUpdate();
+                return jobHasFinished;
+            }
+
+            owner.field.readDownsampledRow (sourceX, sourceY + (int64) y * step, step,
+                                            values + y * tileSize, tileSize);
+        }
+
+        loaded.set (1);
+        owner.triggerAsyncUpdate();
+
+        return jobHasFinished;
+    }
+
+    bool isLoaded() const noexcept
+    {
+        return loaded.get() != 0;
+    }
+
+    /** Returns true if the tile stopped reading part way through. */
+    bool wasInterrupted() const noexcept
+    {
+        return interrupted.get() != 0;
+    }
+
+    void clearInterrupted() noexcept
+    {
+        interrupted.set (0);
+    }
+
+    /** Returns the image of the tile, colouring it first if the table has changed. */
+    const Image& getImage (const PixelARGB* lookupTable, const Range<float>& valueRange, uint32 version)
+    {
+        using namespace ScalarFieldViewHelpers;
+
+        jassert (isLoaded());
+
+        if (! hasColours || colourVersion != version)
+        {
+            if (image.isNull())
+                image = Image (Image::ARGB, tileSize, tileSize, false);
+
+            const float start = valueRange.getStart();
+            const float scale = (lookupTableSize - 1) / valueRange.getLength();
+            const float maxIndex = (float) (lookupTableSize - 1);
+            const PixelARGB missing (0, 0, 0, 0);
+
+            Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < tileSize; ++y)
+            {
+                PixelARGB* dest = reinterpret_cast<PixelARGB*> (data.getLinePointer (y));
+                const float* src = values + y * tileSize;
+
+                for (int x = 0; x < tileSize; ++x)
+                {
+                    // values far outside the range, or infinite, can't be converted
+                    // to an int so this is clamped before the conversion
+                    const float index = (src[x] - start) * scale;
+
+                    if (index == index) // skips NaNs
+                        dest[x] = lookupTable[(int) jlimit (0.0f, maxIndex, index)];
+                    else
+                        dest[x] = missing;
+                }
+            }
+
+            colourVersion = version;
+            hasColours = true;
+        }
+
+        return image;
+    }
+
+    //==============================================================================
+    const int level, tileX, tileY;
+    uint32 lastUsed;
+
+private:
+    //==============================================================================
+    ScalarFieldView& owner;
+    HeapBlock<float> values;
+    Atomic<int> loaded, interrupted;
+    Image image;
+    uint32 colourVersion;
+    bool hasColours;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Tile);
+};
+
+//==============================================================================
+/** Samples the field to find its range of values without blocking the message thread. */
+class ScalarFieldView::ValueRangeJob :  public ThreadPoolJob
+{
+public:
+    ValueRangeJob (ScalarFieldView& owner_)
+        : ThreadPoolJob ("Scalar field value range"), owner (owner_)
+    {
+    }
+
+    JobStatus runJob()
+    {
+        const Range<float> range (owner.field.findValueRange (this));
+
+        if (! shouldExit())
+        {
+            {
+                const ScopedLock sl (owner.foundValueRangeLock);
+                owner.foundValueRange = range;
+                owner.valueRangeFound = true;
+            }
+
+            owner.triggerAsyncUpdate();
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    ScalarFieldView& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (ValueRangeJob);
+};
+
+//==============================================================================
+ScalarFieldView::ScalarFieldView (GradientModel* modelToUse, int numThreads)
+    : model (modelToUse),
+      threadPool (jmax (1, numThreads)),
+      paintCounter (0),
+      lookupTable ((size_t) ScalarFieldViewHelpers::lookupTableSize),
+      lookupTableVersion (0),
+      valueRange (0.0f, 1.0f),
+      hasValueRange (false),
+      valueRangeFound (false),
+      viewScale (1.0),
+      hasBeenFitted (false)
+{
+    jassert (modelToUse != nullptr);
+
+    lookupTableVersion = model->getVersion() + 1; // forces the table to be built
+    updateLookupTable();
+
+    model->addListener (this);
+}
+
+ScalarFieldView::~ScalarFieldView()
+{
+    model->removeListener (this);
+    closeField();
+}
+
+//==============================================================================
+bool ScalarFieldView::openField (const File& file, const ScalarField::Format& format)
+{
+    closeField();
+
+    if (! field.open (file, format))
+        return false;
+
+    // this goes in before any tiles so it's the first thing read
+    threadPool.addJob (new ValueRangeJob (*this), true);
+
+    hasBeenFitted = false;
+    fitFieldToView();
+
+    return true;
+}
+
+void ScalarFieldView::closeField()
+{
+    // this also waits for the value range job to stop
+    removeAllTiles();
+    field.close();
+
+    {
+        const ScopedLock sl (foundValueRangeLock);
+        valueRangeFound = false;
+    }
+
+    valueRange = Range<float> (0.0f, 1.0f);
+    hasValueRange = false;
+
+    repaint();
+}
+
+void ScalarFieldView::fitFieldToView()
+{
+    if (! field.isOpen() || getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    viewScale = jmax (field.getWidth() / (double) getWidth(),
+                      field.getHeight() / (double) getHeight());
+    viewOrigin.setXY (field.getWidth() / 2.0 - getWidth() * viewScale / 2.0,
+                      field.getHeight() / 2.0 - getHeight() * viewScale / 2.0);
+    hasBeenFitted = true;
+
+    repaint();
+}
+
+//==============================================================================
+void ScalarFieldView::paint (Graphics& g)
+{
+    using namespace ScalarFieldViewHelpers;
+
+    g.fillAll (Colours::darkgrey);
+
+    if (! field.isOpen())
+    {
+        g.setColour (Colours::white);
+        g.setFont (13.0f);
+        g.drawFittedText ("Open a raw float32 or uint16 field to preview the gradient on real data",
+                          10, 10, getWidth() - 20, getHeight() - 20,
+                          Justification::centred, 3);
+        return;
+    }
+
+    updateLookupTable();
+    ++paintCounter;
+
+    // pick the level whose tiles have about one value per physical pixel
+    const double displayScale = GradientImageCache::getScaleFactorFor (*this);
+    const int level = getLevelForScale (viewScale / displayScale);
+    const double tileSourceSize = (double) tileSize * (1 << level);
+
+    const int numTilesX = (int) std::ceil (field.getWidth() / tileSourceSize);
+    const int numTilesY = (int) std::ceil (field.getHeight() / tileSourceSize);
+    const int firstX = jmax (0, (int) std::floor (viewOrigin.getX() / tileSourceSize));
+    const int firstY = jmax (0, (int) std::floor (viewOrigin.getY() / tileSourceSize));
+    const int lastX = jmin (numTilesX - 1, (int) std::floor ((viewOrigin.getX() + getWidth() * viewScale) / tileSourceSize));
+    const int lastY = jmin (numTilesY - 1, (int) std::floor ((viewOrigin.getY() + getHeight() * viewScale) / tileSourceSize));
+    int numLoading = 0;
+
+    g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+
+    for (int tileY = firstY; tileY <= lastY; ++tileY)
+    {
+        for (int tileX = firstX; tileX <= lastX; ++tileX)
+        {
+            Tile* tile = findOrCreateTile (level, tileX, tileY);
+            tile->lastUsed = paintCounter;
+
+            // nothing can be coloured until the range of values is known
+            if (! hasValueRange)
+                continue;
+
+            if (tile->isLoaded())
+            {
+                drawTile (g, *tile);
+            }
+            else
+            {
+                drawFallbackTile (g, level, tileX, tileY);
+                ++numLoading;
+            }
+        }
+    }
+
+    removeUnusedTiles();
+
+    String status;
+    status << field.getFile().getFileName() << "  "
+           << field.getWidth() << " x " << field.getHeight() << "  1:" << (1 << level);
+
+    if (! hasValueRange)
+        status << "  finding the range of values";
+    else if (numLoading > 0)
+        status << "  loading " << numLoading << " tiles";
+
+    g.setColour (Colours::white.withAlpha (0.8f));
+    g.setFont (11.0f);
+    g.drawText (status, 4, getHeight() - 16, getWidth() - 8, 14, Justification::bottomLeft, true);
+}
+
+void ScalarFieldView::resized()
+{
+    if (! hasBeenFitted)
+        fitFieldToView();
+}
+
+void ScalarFieldView::mouseDown (const MouseEvent&)
+{
+    dragStartOrigin = viewOrigin;
+}
+
+void ScalarFieldView::mouseDrag (const MouseEvent& e)
+{
+    viewOrigin.setXY (dragStartOrigin.getX() - e.getDistanceFromDragStartX() * viewScale,
+                      dragStartOrigin.getY() - e.getDistanceFromDragStartY() * viewScale);
+    repaint();
+}
+
+void ScalarFieldView::mouseDoubleClick (const MouseEvent&)
+{
+    fitFieldToView();
+}
+
+void ScalarFieldView::mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel)
+{
+    setViewScale (viewScale * jlimit (0.25, 4.0, 1.0 - wheel.deltaY),
+                  Point<double> (e.x, e.y));
+}
+
+void ScalarFieldView::gradientChanged (GradientModel* /*model*/)
+{
+    // only the colours need updating, which happens when the tiles are next drawn
+    if (field.isOpen())
+        repaint();
+}
+
+void ScalarFieldView::handleAsyncUpdate()
+{
+    if (! hasValueRange)
+    {
+        const ScopedLock sl (foundValueRangeLock);
+
+        if (valueRangeFound)
+        {
+            valueRange = foundValueRange;
+            hasValueRange = true;
+        }
+    }
+
+    repaint();
+}
+
+//==============================================================================
+void ScalarFieldView::updateLookupTable()
+{
+    using namespace ScalarFieldViewHelpers;
+
+    if (lookupTableVersion != model->getVersion())
+    {
+        const double scale = 1.0 / (lookupTableSize - 1);
+
+        for (int i = 0; i < lookupTableSize; ++i)
+            lookupTable[i] = model->getColourAtPosition (i * scale).getPixelARGB();
+
+        lookupTableVersion = model->getVersion();
+    }
+}
+
+ScalarFieldView::Tile* ScalarFieldView::findTile (int level, int tileX, int tileY) const
+{
+    for (int i = 0; i < tiles.size(); ++i)
+    {
+        Tile* tile = tiles.getUnchecked (i);
+
+        if (tile->level == level && tile->tileX == tileX && tile->tileY == tileY)
+            return tile;
+    }
+
+    return nullptr;
+}
+
+ScalarFieldView::Tile* ScalarFieldView::findOrCreateTile (int level, int tileX, int tileY)
+{
+    Tile* tile = findTile (level, tileX, tileY);
+
+    if (tile == nullptr)
+    {
+        tile = new Tile (*this, level, tileX, tileY);
+        tiles.add (tile);
+    }
+
+    // this may have been stopped when it went out of view
+    if (! tile->isLoaded())
+    {
+        if (! threadPool.contains (tile))
+        {
+            tile->clearInterrupted();
+            threadPool.addJob (tile, false);
+        }
+        else if (tile->wasInterrupted())
+        {
+            // it's still on its way out of the pool, so look again once it's gone
+            triggerAsyncUpdate();
+        }
+    }
+
+    return tile;
+}
+
+void ScalarFieldView::drawTile (Graphics& g, Tile& tile)
+{
+    using namespace ScalarFieldViewHelpers;
+
+    const Image& image = tile.getImage (lookupTable, valueRange, lookupTableVersion);
+    const Rectangle<int> area (getTileArea (tile.level, tile.tileX, tile.tileY));
+
+    g.drawImage (image,
+                 area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                 0, 0, tileSize, tileSize);
+}
+
+void ScalarFieldView::drawFallbackTile (Graphics& g, int level, int tileX, int tileY)
+{
+    using namespace ScalarFieldViewHelpers;
+
+    for (int levelsUp = 1; levelsUp <= maxFallbackLevels && level + levelsUp <= maxLevel; ++levelsUp)
+    {
+        Tile* parent = findTile (level + levelsUp, tileX >> levelsUp, tileY >> levelsUp);
+
+        if (parent != nullptr && parent->isLoaded())
+        {
+            // stretch the part of the coarser tile that covers this one
+            const int subSize = tileSize >> levelsUp;
+            const int mask = (1 << levelsUp) - 1;
+            const Image& image = parent->getImage (lookupTable, valueRange, lookupTableVersion);
+            const Rectangle<int> area (getTileArea (level, tileX, tileY));
+
+            g.drawImage (image,
+                         area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                         (tileX & mask) * subSize, (tileY & mask) * subSize, subSize, subSize);
+
+            parent->lastUsed = paintCounter;
+            return;
+        }
+    }
+}
+
+void ScalarFieldView::removeUnusedTiles()
+{
+    using namespace ScalarFieldViewHelpers;
+
+    // stop reading any tiles that have gone out of view before they've loaded. If
+    // one is already being read it'll be removed on a later paint once it stops
+    for (int i = tiles.size(); --i >= 0;)
+    {
+        Tile* tile = tiles.getUnchecked (i);
+
+        if (tile->lastUsed != paintCounter && ! tile->isLoaded()
+             && threadPool.removeJob (tile, true, 0))
+            tiles.remove (i);
+    }
+
+    // then throw away the least recently used of the others. This is called while
+    // painting so it mustn't wait: tiles whose jobs are still running are skipped
+    // and left for a later paint
+    while (tiles.size() > maxNumTiles)
+    {
+        int oldest = -1;
+
+        for (int i = 0; i < tiles.size(); ++i)
+        {
+            Tile* tile = tiles.getUnchecked (i);
+
+            if (tile->lastUsed != paintCounter && ! threadPool.isJobRunning (tile)
+                 && (oldest < 0 || tile->lastUsed < tiles.getUnchecked (oldest)->lastUsed))
+                oldest = i;
+        }
+
+        if (oldest < 0 || ! threadPool.removeJob (tiles.getUnchecked (oldest), false, 0))
+            break;
+
+        tiles.remove (oldest);
+    }
+}
+
+void ScalarFieldView::removeAllTiles()
+{
+    threadPool.removeAllJobs (true, -1);
+    tiles.clear();
+}
+
+//==============================================================================
+int ScalarFieldView::getLevelForScale (double sourcePixelsPerPhysicalPixel) const
+{
+    int level = 0;
+
+    while (level < ScalarFieldViewHelpers::maxLevel && (2 << level) <= sourcePixelsPerPhysicalPixel)
+        ++level;
+
+    return level;
+}
+
+Rectangle<int> ScalarFieldView::getTileArea (int level, int tileX, int tileY) const
+{
+    const double tileSourceSize = (double) ScalarFieldViewHelpers::tileSize * (1 << level);
+
+    const int x1 = roundToInt ((tileX * tileSourceSize - viewOrigin.getX()) / viewScale);
+    const int y1 = roundToInt ((tileY * tileSourceSize - viewOrigin.getY()) / viewScale);
+    const int x2 = roundToInt (((tileX + 1) * tileSourceSize - viewOrigin.getX()) / viewScale);
+    const int y2 = roundToInt (((tileY + 1) * tileSourceSize - viewOrigin.getY()) / viewScale);
+
+    return Rectangle<int> (x1, y1, x2 - x1, y2 - y1);
+}
+
+void ScalarFieldView::setViewScale (double newScale, const Point<double>& anchor)
+{
+    using namespace ScalarFieldViewHelpers;
+
+    if (! field.isOpen() || getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    // don't let the field get much smaller than the view
+    const double maxViewScale = 4.0 * jmax (field.getWidth() / (double) getWidth(),
+                                            field.getHeight() / (double) getHeight());
+    newScale = jlimit (minViewScale, jmax (minViewScale, maxViewScale), newScale);
+
+    // keep the value under the anchor in the same place
+    viewOrigin.setXY (viewOrigin.getX() + anchor.getX() * (viewScale - newScale),
+                      viewOrigin.getY() + anchor.getY() * (viewScale - newScale));
+    viewScale = newScale;
+
+    repaint();
+}
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    ScalarFieldView.h
+    Created: 19 Oct 2026 4:58:49am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __SCALARFIELDVIEW_H_3F97A2C6__
+#define __SCALARFIELDVIEW_H_3F97A2C6__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientModel.h"
+#include "ScalarField.h"
+
+
+//==============================================================================
+/**
+    Previews a gradient by using it as the colour map for a large ScalarField.
+
+    The field is split into tiles at a number of power-of-two downsampling levels.
+    Only the tiles covering the visible area at the level matching the current zoom
+    are read, which happens on a pool of background threads. While a tile is
+    loading, any coarser tile already loaded is stretched to fill its place.
+
+    Each tile keeps the downsampled values it read as well as the coloured image,
+    so when the gradient changes the visible tiles are just re-coloured from a
+    look-up table without touching the file again.
+
+    The range of values that the gradient is stretched across is found on the
+    same threads when a field is opened. Tiles start loading straight away but
+    aren't shown until it's known.
+
+    Drag to pan, use the mouse wheel to zoom around the mouse and double-click to
+    fit the whole field in the view.
+
+    @see ScalarField, GradientModel
+ */
+class ScalarFieldView   : public Component,
+                          public GradientModel::Listener,
+                          private AsyncUpdater
+{
+public:
+    //==============================================================================
+    /** Creates a view that colours fields with a model's gradient.
+
+        @param model        The gradient to use. This must not be null.
+        @param numThreads   The number of threads used to read tiles.
+     */
+    ScalarFieldView (GradientModel* model, int numThreads = 2);
+
+    /** Destructor. */
+    ~ScalarFieldView();
+
+    //==============================================================================
+    /** Opens a field, replacing any existing one and fitting it to the view.
+        @returns true if the file could be mapped
+        @see ScalarField::open
+     */
+    bool openField (const File& file, const ScalarField::Format& format);
+
+    /** Closes the current field, waiting for any tiles being read to finish. */
+    void closeField();
+
+    /** Returns the field being shown. */
+    const ScalarField& getField() const noexcept        { return field; }
+
+    /** Zooms and centres the view so that the whole field is visible. */
+    void fitFieldToView();
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics& g);
+
+    /** @internal */
+    void resized();
+
+    /** @internal */
+    void mouseDown (const MouseEvent& e);
+
+    /** @internal */
+    void mouseDrag (const MouseEvent& e);
+
+    /** @internal */
+    void mouseDoubleClick (const MouseEvent& e);
+
+    /** @internal */
+    void mouseWheelMove (const MouseEvent& e, const MouseWheelDetails& wheel);
+
+    /** @internal */
+    void gradientChanged (GradientModel* model);
+
+private:
+    //==============================================================================
+    class Tile;
+    class ValueRangeJob;
+    friend class Tile;
+    friend class ValueRangeJob;
+
+    GradientModel::Ptr model;
+    ScalarField field;
+    ThreadPool threadPool;
+    OwnedArray<Tile> tiles;
+    uint32 paintCounter;
+
+    HeapBlock<PixelARGB> lookupTable;
+    uint32 lookupTableVersion;
+
+    Range<float> valueRange;
+    bool hasValueRange;
+
+    CriticalSection foundValueRangeLock;
+    Range<float> foundValueRange;
+    bool valueRangeFound;
+
+    Point<double> viewOrigin, dragStartOrigin;
+    double viewScale;
+    bool hasBeenFitted;
+
+    //==============================================================================
+    void handleAsyncUpdate();
+
+    void updateLookupTable();
+    Tile* findTile (int level, int tileX, int tileY) const;
+    Tile* findOrCreateTile (int level, int tileX, int tileY);
+    void drawTile (Graphics& g, Tile& tile);
+    void drawFallbackTile (Graphics& g, int level, int tileX, int tileY);
+    void removeUnusedTiles();
+    void removeAllTiles();
+
+    int getLevelForScale (double sourcePixelsPerPhysicalPixel) const;
+    Rectangle<int> getTileArea (int level, int tileX, int tileY) const;
+    void setViewScale (double newScale, const Point<double>& anchor);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScalarFieldView);
+};
+
+
+#endif  // __SCALARFIELDVIEW_H_3F97A2C6__
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    SharedGradientPublisher.cpp
+    Created: 19 Oct 2026 4:42:54am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "SharedGradientPublisher.h"
+
+#if JUCE_MAC || JUCE_LINUX
+ #include "SharedGradientReader.h"
+#endif
+
+
+//==============================================================================
+SharedGradientPublisher::SharedGradientPublisher (GradientModel& model_,
+                                                  int maxNumStops_,
+                                                  int lookupTableSize_)
+    : model (model_),
+      maxNumStops (jmax (2, maxNumStops_)),
+      lookupTableSize (jmax (2, lookupTableSize_)),
+      header (nullptr),
+      mappedSize (0),
+      segmentDevice (0),
+      segmentInode (0)
+{
+}
+
+SharedGradientPublisher::~SharedGradientPublisher()
+{
+    stop();
+}
+
+//==============================================================================
+#if JUCE_MAC || JUCE_LINUX
+
+bool SharedGradientPublisher::start (const String& newSegmentName)
+{
+    stop();
+
+    segmentName = newSegmentName;
+
+    if (! createSegment())
+    {
+        segmentName = String::empty;
+        return false;
+    }
+
+    model.addListener (this);
+    publish();
+
+    return true;
+}
+
+void SharedGradientPublisher::stop()
+{
+    if (header != nullptr)
+    {
+        model.removeListener (this);
+        removeSegment();
+        segmentName = String::empty;
+    }
+}
+
+bool SharedGradientPublisher::createSegment()
+{
+    using namespace SharedGradientLayout;
+
+    jassert (header == nullptr);
+
+    // only one publisher can own a segment as the sequence lock assumes a single
+    // writer, so this fails if the name is already in use
+    const int fd = shm_open (segmentName.toUTF8(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+    if (fd < 0)
+        return false;
+
+    const size_t size = getTotalSize ((uint32_t) maxNumStops, (uint32_t) lookupTableSize);
+    struct stat info;
+
+    if (fstat (fd, &info) == 0 && ftruncate (fd, (off_t) size) == 0)
+    {
+        void* data = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (data != MAP_FAILED)
+        {
+            header = data;
+            mappedSize = size;
+            segmentDevice = (uint64) info.st_dev;
+            segmentInode = (uint64) info.st_ino;
+        }
+    }
+
+    ::close (fd);
+
+    if (header == nullptr)
+    {
+        shm_unlink (segmentName.toUTF8());
+        return false;
+    }
+
+    Header* h = static_cast<Header*> (header);
+    h->sequence = 0;
+    h->numStops = 0;
+    h->maxNumStops = (uint32_t) maxNumStops;
+    h->lutSize = (uint32_t) lookupTableSize;
+    h->version = layoutVersion;
+    memoryBarrier();
+    h->magic = magicNumber;
+
+    return true;
+}
+
+void SharedGradientPublisher::removeSegment()
+{
+    if (header != nullptr)
+    {
+        // let any readers still mapping the segment know nothing more will come
+        SharedGradientLayout::memoryBarrier();
+        static_cast<SharedGradientLayout::Header*> (header)->magic = 0;
+        SharedGradientLayout::memoryBarrier();
+
+        munmap (header, mappedSize);
+
+        if (ownsSegmentName())
+            shm_unlink (segmentName.toUTF8());
+
+        header = nullptr;
+        mappedSize = 0;
+    }
+}
+
+bool SharedGradientPublisher::ownsSegmentName() const
+{
+    // the segment may have been unlinked and the name reused by someone else since
+    // it was created, in which case it's not ours to remove
+    const int fd = shm_open (segmentName.toUTF8(), O_RDONLY, 0);
+
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    const bool isSameSegment = fstat (fd, &info) == 0
+                                && (uint64) info.st_dev == segmentDevice
+                                && (uint64) info.st_ino == segmentInode;
+    ::close (fd);
+
+    return isSameSegment;
+}
+
+void SharedGradientPublisher::publish()
+{
+    using namespace SharedGradientLayout;
+
+    const int numStops = model.getNumStops();
+
+    if (numStops > maxNumStops)
+    {
+        // there's no room for all the stops, so swap the segment for a bigger one
+        removeSegment();
+        maxNumStops = jmax (numStops, maxNumStops * 2);
+
+        if (! createSegment())
+        {
+            jassertfalse; // someone else has taken the name in the meantime
+            model.removeListener (this);
+            segmentName = String::empty;
+            return;
+        }
+    }
+
+    // this reads straight from the model's stops rather than building a
+    // ColourGradient so that publishing an edit doesn't allocate anything
+    Header* h = static_cast<Header*> (header);
+
+    ++(h->sequence);
+    memoryBarrier();
+
+    Stop* stops = getStops (h);
+
+    for (int i = 0; i < numStops; ++i)
+    {
+        stops[i].position = model.getStopPosition (i);
+        stops[i].argb = model.getStopColour (i).getARGB();
+        stops[i].reserved = 0;
+    }
+
+    uint32_t* lut = getLookupTable (h);
+
+    const double scale = 1.0 / (lookupTableSize - 1);
+
+    for (int i = 0; i < lookupTableSize; ++i)
+        lut[i] = model.getColourAtPosition (i * scale).getARGB();
+
+    h->numStops = (uint32_t) numStops;
+
+    memoryBarrier();
+    ++(h->sequence);
+}
+
+#else
+
+bool SharedGradientPublisher::start (const String&)
+{
+    jassertfalse; // POSIX shared memory isn't available on this platform
+    return false;
+}
+
+void SharedGradientPublisher::stop()
+{
+}
+
+bool SharedGradientPublisher::createSegment()
+{
+    return false;
+}
+
+void SharedGradientPublisher::removeSegment()
+{
+}
+
+bool SharedGradientPublisher::ownsSegmentName() const
+{
+    return false;
+}
+
+void SharedGradientPublisher::publish()
+{
+}
+
+#endif
+
+//==============================================================================
+void SharedGradientPublisher::gradientChanged (GradientModel* /*model*/)
+{
+    if (header != nullptr)
+        publish();
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    SharedGradientPublisher.h
+    Created: 19 Oct 2026 4:42:54am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __SHAREDGRADIENTPUBLISHER_H_0E6B49D3__
+#define __SHAREDGRADIENTPUBLISHER_H_0E6B49D3__
+
+#include "../JuceLibraryCode/JuceHeader.h"
+#include "GradientModel.h"
+
+
+//==============================================================================
+/**
+    Publishes a GradientModel into a named POSIX shared memory segment.
+
+    Every time the model changes its stops and a look-up table are written into
+    the segment so that other processes on the same machine can pick up edits as
+    they happen. Use the stand-alone SharedGradientReader.h in the other process
+    to read them.
+
+    If the gradient grows past the number of stops the segment has room for, the
+    segment is replaced by a bigger one with the same name. Readers of the old one
+    will see that its publisher has stopped and should open the name again.
+
+    This is only available on Mac and Linux, on other platforms start() will
+    always fail.
+
+    @see SharedGradientReader, GradientModel
+ */
+class SharedGradientPublisher :   public GradientModel::Listener
+{
+public:
+    //==============================================================================
+    /** Creates a publisher for a model. Nothing is published until start() is called.
+
+        @param model            The model to publish. This must outlive the publisher.
+        @param maxNumStops      The number of stops to make room for in the segment
+                                to begin with.
+        @param lookupTableSize  The number of entries in the published look-up table.
+     */
+    SharedGradientPublisher (GradientModel& model,
+                             int maxNumStops = 1024,
+                             int lookupTableSize = 1024);
+
+    /** Destructor. This will stop publishing and remove the segment. */
+    ~SharedGradientPublisher();
+
+    //==============================================================================
+    /** Creates the named segment and publishes the current gradient to it.
+        The name should start with a slash e.g. "/my-gradient".
+
+        Each segment can only have one publisher, so this will fail if a segment
+        with the name already exists, whether it belongs to another designer or was
+        left behind by one that crashed. Stale segments can be removed with
+        shm_unlink() or by deleting them from /dev/shm on Linux.
+
+        @returns true if the segment was created successfully
+     */
+    bool start (const String& segmentName);
+
+    /** Stops publishing and removes the segment.
+        The segment is marked as closed first, so readers that already have it
+        mapped can see that the publisher has gone. The name is only removed if it
+        still refers to the segment this created.
+     */
+    void stop();
+
+    /** Returns true if the gradient is currently being published. */
+    bool isPublishing() const noexcept          { return header != nullptr; }
+
+    /** Returns the name of the segment being published to. */
+    const String& getSegmentName() const noexcept   { return segmentName; }
+
+    /** Returns the number of stops the segment currently has room for. */
+    int getMaxNumStops() const noexcept             { return maxNumStops; }
+
+    //==============================================================================
+    /** @internal */
+    void gradientChanged (GradientModel* model);
+
+private:
+    //==============================================================================
+    GradientModel& model;
+    int maxNumStops;
+    const int lookupTableSize;
+
+    String segmentName;
+    void* header;
+    size_t mappedSize;
+    uint64 segmentDevice, segmentInode;
+
+    bool createSegment();
+    void removeSegment();
+    bool ownsSegmentName() const;
+    void publish();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedGradientPublisher);
+};
+
+
+#endif  // __SHAREDGRADIENTPUBLISHER_H_0E6B49D3__
@@ -0,0 +1,283 @@
+/*
+  ==============================================================================
+
+    SharedGradientReader.h
+    Created: 19 Oct 2026 4:42:54am
+    Author:  agent
+
+  ==============================================================================
+*/
+
+#ifndef __SHAREDGRADIENTREADER_H_D5F2C871__
+#define __SHAREDGRADIENTREADER_H_D5F2C871__
+
+/*  This file is deliberately stand-alone so it can be dropped into other
+    projects that want to read a gradient published by a GradientDesigner.
+    It doesn't need JUCE, just a POSIX system and a gcc or clang compiler.
+*/
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+//==============================================================================
+/**
+    The layout of a gradient published to a POSIX shared memory segment.
+
+    The segment starts with a Header, followed by Header::maxNumStops Stop
+    structures and then Header::lutSize 32-bit ARGB look-up table entries.
+    The colours are not premultiplied.
+
+    Access is protected by a sequence lock. The writer increments the sequence
+    number before it starts changing anything and again once it has finished so
+    readers should only trust data read while the number was even and unchanged.
+
+    When the writer stops publishing it clears the magic number before removing
+    the segment, so readers that still have it mapped can tell it has gone.
+ */
+namespace SharedGradientLayout
+{
+    enum
+    {
+        magicNumber     = 0x4744534d,   // 'GDSM'
+        layoutVersion   = 1
+    };
+
+    struct Header
+    {
+        volatile uint32_t magic;
+        uint32_t version;
+        volatile uint32_t sequence;
+        uint32_t numStops;
+        uint32_t maxNumStops;
+        uint32_t lutSize;
+    };
+
+    struct Stop
+    {
+        double position;
+        uint32_t argb;
+        uint32_t reserved;
+    };
+
+    /** Returns the number of bytes needed for a segment with the given capacities. */
+    inline size_t getTotalSize (uint32_t maxNumStops, uint32_t lutSize)
+    {
+        return sizeof (Header) + maxNumStops * sizeof (Stop) + lutSize * sizeof (uint32_t);
+    }
+
+    inline Stop* getStops (Header* header)
+    {
+        return reinterpret_cast<Stop*> (header + 1);
+    }
+
+    inline uint32_t* getLookupTable (Header* header)
+    {
+        return reinterpret_cast<uint32_t*> (getStops (header) + header->maxNumStops);
+    }
+
+    inline void memoryBarrier()
+    {
+        __sync_synchronize();
+    }
+}
+
+//==============================================================================
+/**
+    Maps a gradient published by a SharedGradientPublisher and reads consistent
+    snapshots of it.
+
+    A typical renderer will call hasChanged() once per frame and only call
+    read() when it returns true, re-opening the segment if the publisher has
+    stopped, e.g.
+
+    @code
+    SharedGradientReader reader;
+
+    if ((reader.isOpen() && ! reader.hasPublisherStopped()) || reader.open ("/my-gradient"))
+        if (reader.hasChanged())
+            reader.read (myLookupTable, reader.getLookupTableSize(), 0, 0, 0, 0);
+    @endcode
+ */
+class SharedGradientReader
+{
+public:
+    //==============================================================================
+    SharedGradientReader()
+        : header (0), mappedSize (0), lastSequence (0)
+    {
+    }
+
+    ~SharedGradientReader()
+    {
+        close();
+    }
+
+    //==============================================================================
+    /** Maps the named segment, returning false if it doesn't exist or isn't valid. */
+    bool open (const char* segmentName)
+    {
+        close();
+
+        const int fd = shm_open (segmentName, O_RDONLY, 0);
+
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+
+        if (fstat (fd, &info) == 0 && (size_t) info.st_size >= sizeof (SharedGradientLayout::Header))
+        {
+            void* data = mmap (0, (size_t) info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+            if (data != MAP_FAILED)
+            {
+                header = static_cast<SharedGradientLayout::Header*> (data);
+                mappedSize = (size_t) info.st_size;
+            }
+        }
+
+        ::close (fd);
+
+        if (header != 0
+             && (header->magic != (uint32_t) SharedGradientLayout::magicNumber
+                  || header->version != (uint32_t) SharedGradientLayout::layoutVersion
+                  || mappedSize < SharedGradientLayout::getTotalSize (header->maxNumStops, header->lutSize)))
+            close();
+
+        return header != 0;
+    }
+
+    /** Unmaps the segment. */
+    void close()
+    {
+        if (header != 0)
+            munmap (header, mappedSize);
+
+        header = 0;
+        mappedSize = 0;
+        lastSequence = 0;
+    }
+
+    bool isOpen() const                 { return header != 0; }
+
+    /** Returns the number of entries in the published look-up table. */
+    uint32_t getLookupTableSize() const { return header != 0 ? header->lutSize : 0; }
+
+    /** Returns the maximum number of stops the segment can hold. */
+    uint32_t getMaxNumStops() const     { return header != 0 ? header->maxNumStops : 0; }
+
+    /** Returns a number that changes every time the writer publishes a new gradient. */
+    uint32_t getGeneration() const      { return header != 0 ? header->sequence / 2 : 0; }
+
+    /** Returns true if the publisher has stopped, or replaced the segment with a new
+        one under the same name. Nothing more will be published to this segment, so
+        it should be closed and opened again.
+     */
+    bool hasPublisherStopped() const    { return header != 0 && header->magic != (uint32_t) SharedGradientLayout::magicNumber; }
+
+    /** Returns true if the gradient has been published since the last successful
+        read(), or if the publisher has stopped.
+     */
+    bool hasChanged() const             { return header != 0 && (header->sequence != lastSequence || hasPublisherStopped()); }
+
+    //==============================================================================
+    /** Copies a consistent snapshot of the gradient.
+
+        Any of the destinations can be null if you're not interested in them. This
+        will retry while the writer is part-way through publishing, which only takes
+        a few microseconds. If no consistent snapshot can be taken after
+        maxNumAttempts tries, e.g. because the writer died while publishing, this
+        gives up rather than hanging the caller.
+
+        @param lutDest              Receives up to maxLutEntries ARGB look-up table entries
+        @param stopsDest            Receives up to maxStops stops
+        @param numLutEntriesResult  Receives the number of look-up table entries copied
+        @param numStopsResult       Receives the number of stops in the gradient, which
+                                    may be more than maxStops
+        @param maxNumAttempts       The number of times to try before giving up
+        @returns true if a snapshot was read. This returns false if the segment isn't
+                 open, the publisher has stopped or no consistent snapshot could be
+                 read, in which case the results are set to 0 and the destinations
+                 may hold partial data
+     */
+    bool read (uint32_t* lutDest, uint32_t maxLutEntries,
+               SharedGradientLayout::Stop* stopsDest, uint32_t maxStops,
+               uint32_t* numLutEntriesResult, uint32_t* numStopsResult,
+               int maxNumAttempts = 10000)
+    {
+        if (numLutEntriesResult != 0)
+            *numLutEntriesResult = 0;
+
+        if (numStopsResult != 0)
+            *numStopsResult = 0;
+
+        if (header == 0)
+            return false;
+
+        uint32_t numLutEntries = 0, numStops = 0;
+        bool succeeded = false;
+
+        for (int attempt = 0; attempt < maxNumAttempts; ++attempt)
+        {
+            if (hasPublisherStopped())
+                return false;
+
+            const uint32_t startSequence = header->sequence;
+
+            if ((startSequence & 1) != 0)
+            {
+                sched_yield();
+                continue;
+            }
+
+            SharedGradientLayout::memoryBarrier();
+
+            numLutEntries = header->lutSize < maxLutEntries ? header->lutSize : maxLutEntries;
+            numStops = header->numStops;
+
+            if (lutDest != 0)
+                memcpy (lutDest, SharedGradientLayout::getLookupTable (header), numLutEntries * sizeof (uint32_t));
+
+            if (stopsDest != 0)
+                memcpy (stopsDest, SharedGradientLayout::getStops (header),
+                        (numStops < maxStops ? numStops : maxStops) * sizeof (SharedGradientLayout::Stop));
+
+            SharedGradientLayout::memoryBarrier();
+
+            if (header->sequence == startSequence && ! hasPublisherStopped())
+            {
+                lastSequence = startSequence;
+                succeeded = true;
+                break;
+            }
+        }
+
+        if (! succeeded)
+            return false;
+
+        if (numLutEntriesResult != 0)
+            *numLutEntriesResult = lutDest != 0 ? numLutEntries : 0;
+
+        if (numStopsResult != 0)
+            *numStopsResult = numStops;
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    SharedGradientLayout::Header* header;
+    size_t mappedSize;
+    uint32_t lastSequence;
+
+    SharedGradientReader (const SharedGradientReader&);
+    SharedGradientReader& operator= (const SharedGradientReader&);
+};
+
+
+#endif  // __SHAREDGRADIENTREADER_H_D5F2C871__
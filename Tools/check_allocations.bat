@@ -0,0 +1,28 @@
+@echo off
+rem Builds a copy of the app that counts heap allocations, then replays
+rem edit_cycle.xml through it and fails if editing the gradient allocates once
+rem everything has warmed up. Run this from a Visual Studio command prompt.
+rem
+rem Usage: Tools\check_allocations.bat [recording.xml]
+
+setlocal
+cd /d "%~dp0.."
+
+set RECORDING=%~1
+if "%RECORDING%"=="" set RECORDING=Tools\edit_cycle.xml
+
+set BUILD_DIR=CountAllocations\
+set RESULTS=Builds\VisualStudio2010\%BUILD_DIR%allocation_results.txt
+
+rem counting needs the debug CRT's allocation hook, so this must be a debug build
+set CL=/DGRADIENTDESIGNER_COUNT_ALLOCATIONS=1
+msbuild Builds\VisualStudio2010\GradientDesigner.vcxproj /p:Configuration=Debug /p:Platform=x64 /p:OutDir=%BUILD_DIR% /p:IntDir=%BUILD_DIR%
+if errorlevel 1 exit /b 1
+set CL=
+
+rem it's a GUI app, so wait for it to get its exit code
+start "" /wait Builds\VisualStudio2010\%BUILD_DIR%GradientDesigner.exe --replay "%RECORDING%" --check-allocations --results "%RESULTS%"
+set STATUS=%ERRORLEVEL%
+
+type "%RESULTS%"
+exit /b %STATUS%
@@ -0,0 +1,27 @@
+#!/bin/sh
+# Builds a copy of the Mac app that counts heap allocations, then replays
+# edit_cycle.xml through it and fails if editing the gradient allocates once
+# everything has warmed up.
+#
+# Usage: Tools/check_allocations.sh [recording.xml]
+
+set -e
+
+cd "$(dirname "$0")/.."
+
+RECORDING="${1:-Tools/edit_cycle.xml}"
+BUILD_DIR="Builds/MacOSX/build/CountAllocations"
+RESULTS="$BUILD_DIR/allocation_results.txt"
+
+xcodebuild -project Builds/MacOSX/GradientDesigner.xcodeproj \
+           -configuration Debug \
+           SYMROOT="$PWD/$BUILD_DIR" \
+           OTHER_CFLAGS='$(inherited) -DGRADIENTDESIGNER_COUNT_ALLOCATIONS=1' \
+           build
+
+STATUS=0
+"$BUILD_DIR/Debug/GradientDesigner.app/Contents/MacOS/GradientDesigner" \
+    --replay "$RECORDING" --check-allocations --results "$RESULTS" || STATUS=$?
+
+cat "$RESULTS"
+exit $STATUS